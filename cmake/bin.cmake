@@ -27,6 +27,21 @@ set(BIN_TEST_PCB kernel-test-pcb)
 add_executable(${BIN_TEST_PCB} ${BIN_PATH}/test_pcb.c)
 target_link_libraries(${BIN_TEST_PCB} PRIVATE ${BIKAYA_LIBS})
 
+set(BIN_TEST_TREE kernel-test-tree)
+add_executable(${BIN_TEST_TREE} ${BIN_PATH}/test_tree.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_TEST_TREE} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_TEST_TREE} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_TEST_SLEEPQ kernel-test-sleepq)
+add_executable(${BIN_TEST_SLEEPQ} ${BIN_PATH}/test_sleepq.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_TEST_SLEEPQ} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_TEST_SLEEPQ} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_TEST_SLEEP kernel-test-sleep)
+add_executable(${BIN_TEST_SLEEP} ${BIN_PATH}/test_sleep.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_TEST_SLEEP} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_TEST_SLEEP} PRIVATE ${BIKAYA_LIBS})
+
 set(BIN_HELLO_WORLD kernel-hello-world)
 add_executable(${BIN_HELLO_WORLD} ${BIN_PATH}/hello_world.c)
 target_link_libraries(${BIN_HELLO_WORLD} PRIVATE ${BIKAYA_LIBS})
@@ -34,3 +49,73 @@ target_link_libraries(${BIN_HELLO_WORLD} PRIVATE ${BIKAYA_LIBS})
 set(BIN_PRODUCER_CONSUMER kernel-producer-consumer)
 add_executable(${BIN_PRODUCER_CONSUMER} ${BIN_PATH}/producer_consumer.c)
 target_link_libraries(${BIN_PRODUCER_CONSUMER} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_READYQ kernel-bench-readyq)
+add_executable(${BIN_BENCH_READYQ} ${BIN_PATH}/bench_readyq.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_READYQ} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_READYQ} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_IO_OVERLAP kernel-io-overlap)
+add_executable(${BIN_IO_OVERLAP} ${BIN_PATH}/io_overlap.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_IO_OVERLAP} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_IO_OVERLAP} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_PINGPONG_LATENCY kernel-pingpong-latency)
+add_executable(${BIN_PINGPONG_LATENCY} ${BIN_PATH}/pingpong_latency.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_PINGPONG_LATENCY} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_PINGPONG_LATENCY} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_ASL kernel-bench-asl)
+add_executable(${BIN_BENCH_ASL} ${BIN_PATH}/bench_asl.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_ASL} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_ASL} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_KILL_TREE kernel-bench-kill-tree)
+add_executable(${BIN_BENCH_KILL_TREE} ${BIN_PATH}/bench_kill_tree.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_KILL_TREE} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_KILL_TREE} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_TREE kernel-bench-tree)
+add_executable(${BIN_BENCH_TREE} ${BIN_PATH}/bench_tree.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_TREE} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_TREE} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_DISPATCH kernel-bench-dispatch)
+add_executable(${BIN_BENCH_DISPATCH} ${BIN_PATH}/bench_dispatch.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_DISPATCH} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_DISPATCH} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_GETPID kernel-bench-getpid)
+add_executable(${BIN_BENCH_GETPID} ${BIN_PATH}/bench_getpid.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_GETPID} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_GETPID} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_MEMORY kernel-bench-memory)
+add_executable(${BIN_BENCH_MEMORY} ${BIN_PATH}/bench_memory.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_MEMORY} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_MEMORY} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_INTERRUPTS kernel-bench-interrupts)
+add_executable(${BIN_BENCH_INTERRUPTS} ${BIN_PATH}/bench_interrupts.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_INTERRUPTS} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_INTERRUPTS} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_KINFO kernel-bench-kinfo)
+add_executable(${BIN_BENCH_KINFO} ${BIN_PATH}/bench_kinfo.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_KINFO} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_KINFO} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_WRITE kernel-bench-write)
+add_executable(${BIN_BENCH_WRITE} ${BIN_PATH}/bench_write.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_WRITE} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_WRITE} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_SPOOL kernel-bench-spool)
+add_executable(${BIN_BENCH_SPOOL} ${BIN_PATH}/bench_spool.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_SPOOL} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_SPOOL} PRIVATE ${BIKAYA_LIBS})
+
+set(BIN_BENCH_SLEEP kernel-bench-sleep)
+add_executable(${BIN_BENCH_SLEEP} ${BIN_PATH}/bench_sleep.c ${TESTS_PATH}/bench.c)
+target_include_directories(${BIN_BENCH_SLEEP} PRIVATE ${TESTS_PATH})
+target_link_libraries(${BIN_BENCH_SLEEP} PRIVATE ${BIKAYA_LIBS})
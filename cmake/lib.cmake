@@ -9,11 +9,17 @@ add_library(${ARCHIVE_NAME}
   ${ARCHIVE_SOURCES}/assertions.c
   ${ARCHIVE_SOURCES}/helpers.c
   ${ARCHIVE_SOURCES}/memory.c
+  ${ARCHIVE_SOURCES}/slab.c
   ${ARCHIVE_SOURCES}/printer.c
   ${ARCHIVE_SOURCES}/term.c
   ${ARCHIVE_SOURCES}/asl.c
   ${ARCHIVE_SOURCES}/pcb.c
+  ${ARCHIVE_SOURCES}/readyq.c
+  ${ARCHIVE_SOURCES}/sleepq.c
+  ${ARCHIVE_SOURCES}/kinfo.c
   ${ARCHIVE_SOURCES}/scheduler.c
   ${ARCHIVE_SOURCES}/handlers.c
+  ${ARCHIVE_SOURCES}/output.c
+  ${ARCHIVE_SOURCES}/input.c
   ${ARCHIVE_SOURCES}/core.c
 )
@@ -25,5 +25,22 @@ add_custom_command(TARGET ${BIN_PHASE1} POST_BUILD COMMAND umps2-elf2umps -k ${B
 add_custom_command(TARGET ${BIN_PHASE15} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_PHASE15})
 add_custom_command(TARGET ${BIN_PHASE2} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_PHASE2})
 add_custom_command(TARGET ${BIN_TEST_PCB} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_TEST_PCB})
+add_custom_command(TARGET ${BIN_TEST_TREE} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_TEST_TREE})
+add_custom_command(TARGET ${BIN_TEST_SLEEPQ} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_TEST_SLEEPQ})
+add_custom_command(TARGET ${BIN_TEST_SLEEP} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_TEST_SLEEP})
 add_custom_command(TARGET ${BIN_HELLO_WORLD} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_HELLO_WORLD})
 add_custom_command(TARGET ${BIN_PRODUCER_CONSUMER} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_PRODUCER_CONSUMER})
+add_custom_command(TARGET ${BIN_BENCH_READYQ} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_READYQ})
+add_custom_command(TARGET ${BIN_IO_OVERLAP} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_IO_OVERLAP})
+add_custom_command(TARGET ${BIN_PINGPONG_LATENCY} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_PINGPONG_LATENCY})
+add_custom_command(TARGET ${BIN_BENCH_ASL} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_ASL})
+add_custom_command(TARGET ${BIN_BENCH_KILL_TREE} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_KILL_TREE})
+add_custom_command(TARGET ${BIN_BENCH_TREE} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_TREE})
+add_custom_command(TARGET ${BIN_BENCH_DISPATCH} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_DISPATCH})
+add_custom_command(TARGET ${BIN_BENCH_GETPID} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_GETPID})
+add_custom_command(TARGET ${BIN_BENCH_MEMORY} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_MEMORY})
+add_custom_command(TARGET ${BIN_BENCH_INTERRUPTS} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_INTERRUPTS})
+add_custom_command(TARGET ${BIN_BENCH_KINFO} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_KINFO})
+add_custom_command(TARGET ${BIN_BENCH_WRITE} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_WRITE})
+add_custom_command(TARGET ${BIN_BENCH_SPOOL} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_SPOOL})
+add_custom_command(TARGET ${BIN_BENCH_SLEEP} POST_BUILD COMMAND umps2-elf2umps -k ${BIN_BENCH_SLEEP})
@@ -5,6 +5,7 @@
 
 // Semaphore Descriptor (SEMD) data structure
 typedef struct semd_t {
+    // links the semd either in the free list or in the hash bucket of its key
     struct list_head s_next;
 
     // Semaphore key
@@ -14,7 +15,13 @@ typedef struct semd_t {
     struct list_head s_procQ;
 } semd_t;
 
-// ASL handling functions
+/**
+ * ASL handling functions.
+ *
+ * Active semaphores are kept in a hash table (open hashing) indexed by key,
+ * so that looking up a semaphore takes O(1) expected time regardless of the
+ * number of active semaphores (at most MAX_SEM_NO).
+ */
 void initASL(void);
 struct semd_t *getSemd(int *key);
 
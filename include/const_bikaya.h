@@ -52,6 +52,15 @@
 #define SPECPASSUP       7
 #define GETPID           8
 
+/* kernel services registered at boot (see handlers_registerSyscall) */
+#define WRITE            16
+#define READLINE         17
+#define SPOOL            18
+
+/* kernel services beyond phase2 (see handlers.c) */
+#define SLEEP            19
+#define GETCPUTIME64     20
+
 enum ExcType {
     ExcType_Sysbk = 0,
     ExcType_TLB = 1,
@@ -63,6 +72,10 @@ enum ExcType {
 #define TRUE             1
 #define FALSE            0
 
-/* Max number of overall (eg, system, daemons, user) concurrent processes */
+/* Number of processes exercised by the phase 1 test: PCBs are carved on demand (see slab.h) */
 #define MAX_PROC_NO 20
+
+/* Expected number of active semaphores, sizes the hash table of the ASL (build-time parameter, see CMakeLists.txt) */
+#ifndef MAX_SEM_NO
 #define MAX_SEM_NO  20
+#endif
@@ -19,6 +19,7 @@
  * to its underlying architecture:
  *
  * - ticks_t                       : clock ticks type.
+ * - ticks64_t                     : clock ticks type that does not wrap around (64 bits), for accounting.
  * - sysno_t                       : syscall number type.
  * - memaddr                       : memory address type.
  * - cpustate_t                    : self-explaining.
@@ -31,10 +32,12 @@
  * - MACHINE_OLD_TLB_MGMT_AREA     : area in which is stored the old CPU state before handling translation lookaside buffers.
  * - MACHINE_NEW_TLB_MGMT_AREA     : area of the new CPU state when handling translation lookaside buffers.
  * - MACHINE_RAM_LIMIT             : self-explaining.
+ * - MACHINE_IMAGE_END             : first address after the kernel image (code, data and bss).
  * - MACHINE_STACK_SIZE            : functions stack size.
  * - MACHINE_WORD_SIZE             : self-explaining.
  * - MACHINE_DEVICE_PRINTER_NO     : number of printer devices that machine can handle.
  * - MACHINE_DEVICE_TERMINAL_NO    : number of terminal devices that machine can handle.
+ * - MACHINE_DEVICE_PER_LINE_NO    : number of devices attached to each interrupt line.
  * - MACHINE_MAX_INT               : max value represantable by the machine that type int can reach.
  * - INTERRUPT_LINE_IPI            : interrupt line that indicates inter processor interrupts.
  * - INTERRUPT_LINE_CPU_TIMER      : interrupt line that indicates that the CPU timer caused the interruption.
@@ -45,6 +48,10 @@
  * - INTERRUPT_LINE_PRINTER        : interrupt line that indicates that the printer caused the interruption.
  * - INTERRUPT_LINE_TERMINAL       : interrupt line that indicates that the terminal caused the interruption.
  * - INTERVAL_TIMER_MAX            : max value that interval timer can reach.
+ *
+ * Moreover, the functions declared static inline below are implemented once in
+ * hal.h, which is included at the end of this one: each target only names the
+ * fields of its processor state in its own header (include/<target>/hal.h).
  */
 
 #if defined(TARGET_UARM)
@@ -54,10 +61,14 @@
 #include <uarm/uARMtypes.h>
 
 typedef unsigned ticks_t;
+typedef unsigned long long ticks64_t;
 typedef unsigned sysno_t;
 typedef unsigned memaddr;
 typedef state_t cpustate_t;
 
+// defined by the linker script
+extern char _end[];
+
 #define MACHINE_OLD_SYSBK_AREA        ((cpustate_t *) SYSBK_OLDAREA)
 #define MACHINE_NEW_SYSBK_AREA        ((cpustate_t *) SYSBK_NEWAREA)
 
@@ -71,12 +82,14 @@ typedef state_t cpustate_t;
 #define MACHINE_NEW_TLB_MGMT_AREA     ((cpustate_t *) TLB_NEWAREA)
 
 #define MACHINE_RAM_LIMIT             ((unsigned) RAM_TOP)
+#define MACHINE_IMAGE_END             ((memaddr) _end)
 #define MACHINE_STACK_SIZE            ((unsigned) FRAMESIZE)
 
 #define MACHINE_WORD_SIZE             ((unsigned) WORD_SIZE)
 
 #define MACHINE_DEVICE_PRINTER_NO     ((unsigned) N_DEV_PER_IL)
 #define MACHINE_DEVICE_TERMINAL_NO    ((unsigned) N_DEV_PER_IL)
+#define MACHINE_DEVICE_PER_LINE_NO    ((unsigned) N_DEV_PER_IL)
 
 #define MACHINE_MAX_INT               (0x7FFFFFFF)
 
@@ -99,10 +112,14 @@ typedef state_t cpustate_t;
 #include <umps/cp0.h>
 
 typedef unsigned ticks_t;
+typedef unsigned long long ticks64_t;
 typedef unsigned sysno_t;
 typedef unsigned memaddr;
 typedef state_t cpustate_t;
 
+// defined by the linker script
+extern char _end[];
+
 #define MACHINE_OLD_SYSBK_AREA        ((cpustate_t *) 0x20000348)
 #define MACHINE_NEW_SYSBK_AREA        ((cpustate_t *) 0x200003D4)
 
@@ -116,12 +133,14 @@ typedef state_t cpustate_t;
 #define MACHINE_NEW_TLB_MGMT_AREA     ((cpustate_t *) 0x200001A4)
 
 #define MACHINE_RAM_LIMIT             ((unsigned) ((*((unsigned *) BUS_REG_RAM_BASE)) + (*((unsigned *) BUS_REG_RAM_SIZE))))
+#define MACHINE_IMAGE_END             ((memaddr) _end)
 #define MACHINE_STACK_SIZE            (1024U)
 
 #define MACHINE_WORD_SIZE             ((unsigned) WORD_SIZE)
 
 #define MACHINE_DEVICE_PRINTER_NO     ((unsigned) N_DEV_PER_IL)
 #define MACHINE_DEVICE_TERMINAL_NO    ((unsigned) N_DEV_PER_IL)
+#define MACHINE_DEVICE_PER_LINE_NO    ((unsigned) N_DEV_PER_IL)
 
 #define MACHINE_MAX_INT               (0x7FFFFFFF)
 
@@ -144,10 +163,14 @@ typedef state_t cpustate_t;
 
 #define noreturn _Noreturn
 
+// Where to store the times of a process (NULL pointers are ignored): the 32-bit ones wrap around.
 struct TimeInfo {
     ticks_t *userTime;
     ticks_t *kernelTime;
     ticks_t *wallclockTime;
+    ticks64_t *userTime64;
+    ticks64_t *kernelTime64;
+    ticks64_t *wallclockTime64;
 };
 
 /**
@@ -179,6 +202,14 @@ extern void core_loadState(cpustate_t *state);
  */
 extern noreturn void core_halt(void);
 
+/**
+ * Enables device and interval timer interrupts on the current processor and waits
+ * for one of them to be raised: the caller must have loaded the interval timer with
+ * the next event it waits for (INTERVAL_TIMER_MAX if none).
+ * The computation is never resumed: the interrupt handler takes over.
+ */
+extern noreturn void core_idle(void);
+
 /**
  * Stops the execution. It is used when an error occurs.
  */
@@ -191,48 +222,51 @@ extern noreturn void core_panic(void);
 #define unreachable() core_panic()
 
 /**
- * Gets the first (by priority) interrupt line active.
+ * Gets the interrupt lines with a pending interrupt.
  *
- * @attention if no interrupt has been raised, it causes kernel PANIC.
- *
- * @return the interrupt line number.
+ * @return a bitmap in which bit i is set iff the interrupt line i is pending.
  */
-extern unsigned machine_getInterruptLine(void);
+extern unsigned machine_getInterruptLines(void);
 
 /**
- * Gets the (first) device of the interrupt line that caused the interrupt.
+ * Gets the devices of the given interrupt line with a pending interrupt.
  *
- * @attention if no device has raised an interrupt, it causes kernel PANIC.
+ * @attention il must be the line of a device otherwise is CRE.
  *
  * @param il The interrupt line.
- * @return the device number.
+ * @return a bitmap in which bit i is set iff the device i is pending.
  */
-extern unsigned machine_getInterruptDevice(unsigned il);
+extern unsigned machine_getInterruptDevices(unsigned il);
 
 /**
  * Returns instructions per microseconds.
  */
-extern ticks_t machine_getClockResolution(void);
+static inline ticks_t machine_getClockResolution(void);
 
 /**
  * Interval timer getter.
  */
-extern ticks_t machine_getIntervalTimer(void);
+static inline ticks_t machine_getIntervalTimer(void);
 
 /**
  * Returns the current value of the timer and then resets it to INTERVAL_TIMER_MAX.
  */
-extern ticks_t machine_resetIntervalTimer(void);
+static inline ticks_t machine_resetIntervalTimer(void);
 
 /**
  * Interval timer setter.
  */
-extern void machine_setIntervalTimer(ticks_t ticks);
+static inline void machine_setIntervalTimer(ticks_t ticks);
 
 /**
- * Time of the day getter.
+ * Time of the day getter: the low word only, which wraps around every 2^32 ticks.
  */
-extern ticks_t machine_getTODLow(void);
+static inline ticks_t machine_getTODLow(void);
+
+/**
+ * Time of the day getter: both the words, read consistently with each other.
+ */
+static inline ticks64_t machine_getTOD64(void);
 
 /* CPU state interface. */
 
@@ -261,21 +295,21 @@ extern void state_update(cpustate_t *self, struct StateConfig config);
  *
  *  @attention (NULL == self) is a checked runtime error.
  */
-extern memaddr *state_programCounter(cpustate_t *self);
+static inline memaddr *state_programCounter(cpustate_t *self);
 
 /**
  *  Returns state's stack pointer.
  *
  *  @attention (NULL == self) is a checked runtime error.
  */
-extern memaddr state_getStackPointer(const cpustate_t *self);
+static inline memaddr state_getStackPointer(const cpustate_t *self);
 
 /**
  *  Sets state's stack pointer.
  *
  *  @attention (NULL == self) is a checked runtime error.
  */
-extern void state_setStackPointer(cpustate_t *self, memaddr sp);
+static inline void state_setStackPointer(cpustate_t *self, memaddr sp);
 
 /**
  * Returns system call identifier. The state parameter is
@@ -285,7 +319,7 @@ extern void state_setStackPointer(cpustate_t *self, memaddr sp);
  * @attention If the last op of the processor state was not a syscall, it is UB.
  * @attention (NULL == self) is a checked runtime error.
  */
-extern sysno_t state_getSysNo(const cpustate_t *self);
+static inline sysno_t state_getSysNo(const cpustate_t *self);
 
 /**
  * Returns the first argument of the syscall. The state parameter is
@@ -295,7 +329,7 @@ extern sysno_t state_getSysNo(const cpustate_t *self);
  * @attention If the last op of the processor state was not a syscall, it is UB.
  * @attention (NULL == self) is a checked runtime error.
  */
-extern unsigned state_getSysArg1(const cpustate_t *self);
+static inline unsigned state_getSysArg1(const cpustate_t *self);
 
 /**
  * Returns the second argument of the syscall. The state parameter is
@@ -305,7 +339,7 @@ extern unsigned state_getSysArg1(const cpustate_t *self);
  * @attention If the last op of the processor state was not a syscall, it is UB.
  * @attention (NULL == self) is a checked runtime error.
  */
-extern unsigned state_getSysArg2(const cpustate_t *self);
+static inline unsigned state_getSysArg2(const cpustate_t *self);
 
 /**
  * Returns the third argument of the syscall. The state parameter is
@@ -315,7 +349,7 @@ extern unsigned state_getSysArg2(const cpustate_t *self);
  * @attention If the last op of the processor state was not a syscall, it is UB.
  * @attention (NULL == self) is a checked runtime error.
  */
-extern unsigned state_getSysArg3(const cpustate_t *self);
+static inline unsigned state_getSysArg3(const cpustate_t *self);
 
 /**
  * Sets the return value of a system call. 
@@ -325,4 +359,12 @@ extern unsigned state_getSysArg3(const cpustate_t *self);
  * @attention If the last op of the processor state was not a syscall, it is UB.
  * @attention (NULL == self) is a checked runtime error.
  */
-extern void state_setSysReturn(cpustate_t *self, int value);
+static inline void state_setSysReturn(cpustate_t *self, int value);
+
+#if defined(TARGET_UARM)
+#include <uarm/hal.h>
+#elif defined(TARGET_UMPS)
+#include <umps/hal.h>
+#endif
+
+#include <hal.h>
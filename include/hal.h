@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * Implementation of the accessors that core.h declares static inline, so that
+ * the compiler can fold them into the exception handlers. uARM and uMPS share
+ * the layout of the bus registers, thus the bodies are written once here: each
+ * target header (include/<target>/hal.h) only names the fields of its processor
+ * state that hold the registers below.
+ *
+ * - STATE_PC_FIELD                : program counter.
+ * - STATE_SP_FIELD                : stack pointer.
+ * - STATE_SYSNO_FIELD             : system call number.
+ * - STATE_ARG1_FIELD              : first argument of a system call.
+ * - STATE_ARG2_FIELD              : second argument of a system call.
+ * - STATE_ARG3_FIELD              : third argument of a system call.
+ * - STATE_RETURN_FIELD            : return value of a system call.
+ *
+ * Do not include this header directly, include core.h instead.
+ */
+
+#include <assertions.h>
+
+/*
+ * Bus registers are read through volatile pointers: once inlined, two reads
+ * of the same register in a function must not be merged by the compiler.
+ */
+
+static inline ticks_t machine_getClockResolution(void) {
+    return *((volatile ticks_t *) BUS_REG_TIME_SCALE);
+}
+
+static inline ticks_t machine_getIntervalTimer(void) {
+    return *((volatile ticks_t *) BUS_REG_TIMER);
+}
+
+static inline void machine_setIntervalTimer(const ticks_t ticks) {
+    *((volatile ticks_t *) BUS_REG_TIMER) = ticks;
+}
+
+static inline ticks_t machine_resetIntervalTimer(void) {
+    const ticks_t timeLeft = machine_getIntervalTimer();
+    machine_setIntervalTimer(INTERVAL_TIMER_MAX);
+    return timeLeft;
+}
+
+static inline ticks_t machine_getTODLow(void) {
+    return *((volatile ticks_t *) BUS_REG_TOD_LO);
+}
+
+static inline ticks64_t machine_getTOD64(void) {
+    ticks_t high, low;
+
+    // the low word may carry into the high one between the two reads: read again until the high word is stable.
+    do {
+        high = *((volatile ticks_t *) BUS_REG_TOD_HI);
+        low = *((volatile ticks_t *) BUS_REG_TOD_LO);
+    } while (high != *((volatile ticks_t *) BUS_REG_TOD_HI));
+
+    return ((ticks64_t) high << 32) | low;
+}
+
+static inline memaddr *state_programCounter(cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return &self->STATE_PC_FIELD;
+}
+
+static inline memaddr state_getStackPointer(const cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return self->STATE_SP_FIELD;
+}
+
+static inline void state_setStackPointer(cpustate_t *const self, const memaddr sp) {
+    debug_assert(NULL != self);
+    self->STATE_SP_FIELD = sp;
+}
+
+static inline sysno_t state_getSysNo(const cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return self->STATE_SYSNO_FIELD;
+}
+
+static inline unsigned state_getSysArg1(const cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return self->STATE_ARG1_FIELD;
+}
+
+static inline unsigned state_getSysArg2(const cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return self->STATE_ARG2_FIELD;
+}
+
+static inline unsigned state_getSysArg3(const cpustate_t *const self) {
+    debug_assert(NULL != self);
+    return self->STATE_ARG3_FIELD;
+}
+
+static inline void state_setSysReturn(cpustate_t *const self, const int value) {
+    debug_assert(NULL != self);
+    self->STATE_RETURN_FIELD = (unsigned) value;
+}
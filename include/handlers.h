@@ -1,23 +1,86 @@
 #pragma once
 
+#include <primitive_types.h>
+
+#include <core.h>
+
+// size of the system call table: valid system call numbers are in [1, SYSCALL_TABLE_SIZE)
+#define SYSCALL_TABLE_SIZE  32
+
+// What a system call may do besides returning to the caller: the services that
+// can do neither are resumed on the fast path (see scheduler_resumeFast).
+enum SyscallFlag {
+    SyscallFlag_None = 0,
+    SyscallFlag_MayReschedule = 1 << 0,     // may make ready a process that preempts the caller
+    SyscallFlag_MayBlock = 1 << 1,          // may block or terminate the caller (thus never return)
+};
+
+// A system call being served: the arguments are decoded according to the argc of the service.
+struct SyscallCall {
+    cpustate_t *state;              // state of the caller, the return value is set here
+    u32 args[3];                    // arguments of the call, the ones beyond argc are zero
+    ticks_t timeLeft;               // value of the interval timer on entry (it is not reset)
+    struct TimeInfo timeInfo;       // where to store the times of the caller on resume (if any)
+};
+
+// A kernel service reachable through a system call.
+struct Syscall {
+    void (*service)(struct SyscallCall *call);
+    unsigned argc;                  // number of arguments to decode (at most 3)
+    unsigned flags;                 // bitwise or of enum SyscallFlag
+};
+
+// Statistics of the interrupt handler.
+struct InterruptStats {
+    u32 entries;        // number of interrupt exceptions handled
+    u32 devices;        // number of device interrupts acknowledged
+    u32 maxDevices;     // highest number of device interrupts acknowledged by a single entry
+};
+
 /**
  * Stores the current state of the CPU suspending its computation, then it handles
- * the interrupt according to the device that caused it afterwards it resumes the
- * computation loading the correct state of the CPU.
+ * the interrupts of every pending device afterwards it resumes the computation
+ * loading the correct state of the CPU (or dispatches another process when the
+ * time slice has expired).
  *
- * @attention Calling this function while no interrupt has been raised causes a kernel PANIC.
+ * @attention Calling this function while no interrupt has been raised is UB.
  */
 extern void handlers_interruptHandler(void);
 
+/**
+ * Returns the statistics of the interrupt handler: devices / entries is the
+ * average number of devices serviced by each interrupt exception.
+ */
+extern const struct InterruptStats *handlers_getInterruptStats(void);
+
 /**
  * Stores the current state of the CPU suspending its computation, then it executes
- * the specified system call and afterwards it resumes the computation loading
- * the correct state of the CPU.
+ * the specified system call looking up its service in the system call table
+ * (unknown numbers are passed up to the custom handler of the process) and
+ * afterwards it resumes the computation loading the correct state of the CPU.
  *
  * @attention Calling this function while no system call has been called is UB.
  */
 extern void handlers_sysbkHandler(void);
 
+/**
+ * Returns the time spent so far serving the given system call: this is the
+ * handlerTime that services must pass to the scheduler when they block the caller.
+ */
+static inline ticks_t handlers_syscallTime(const struct SyscallCall *const call) {
+    return call->timeLeft - machine_getIntervalTimer();
+}
+
+/**
+ * Registers a new kernel service for the given system call number.
+ * Kernel modules must register their services at boot, before dispatching any process.
+ *
+ * @attention NULL == syscall.service or syscall.argc > 3 is CRE.
+ *
+ * @return false if the number is beyond the table or already taken, true otherwise.
+ */
+extern bool handlers_registerSyscall(sysno_t sysNo, struct Syscall syscall);
+
 /**
  * Calls a custom handler for TLBs.
  *
@@ -9,10 +9,15 @@
  *
  * @attention msg must be a string literal.
  *
+ * Note: the length of the message is known at compile time, thus it is
+ *       queued with a single WRITE syscall (see term_write).
+ *
  * @param msg The massage to be printed.
  */
 #define trace(msg)    \
-    term_puts(0, "[TRACE '" __FILE__ ":" str(__LINE__) "']: " msg "\n")
+    trace_literal("[TRACE '" __FILE__ ":" str(__LINE__) "']: " msg "\n")
+
+#define trace_literal(s)    term_write(0, (s), sizeof(s) - 1)
 
 /**
  * Takes a number n and converts its digits sequentially into their decimal
@@ -33,3 +38,28 @@
  * @return true if each sequantial call to f returned true, false otherwise.
  */
 bool u32_to_base10(bool (*f)(char), u32 n);
+
+/**
+ * Counts the leading zero bits of n, starting from the most significant one.
+ *
+ * Note: none of the supported targets provides a clz instruction (MIPS I and
+ *       ARMv4T) and we do not link against libgcc, so this is implemented
+ *       in software with a branch-bounded binary search.
+ *
+ * @param n The number to be inspected.
+ * @return The number of leading zero bits (32 if n is 0).
+ */
+u32 u32_clz(u32 n);
+
+/**
+ * Returns a pseudo-random number in [0, bound) from a linear congruential
+ * generator, advancing its state: the same seed gives back the same sequence.
+ *
+ * Note: only 32 bits arithmetic is used, since we do not link against libgcc.
+ *
+ * @attention (NULL == seed) or (0 == bound) is a checked runtime error.
+ *
+ * @param seed The state of the generator.
+ * @param bound The upper bound (excluded) of the result.
+ */
+u32 u32_random(u32 *seed, u32 bound);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <core.h>
+
+// size of the receive ring of each terminal (a power of two)
+#define INPUT_RING_SIZE     256U
+
+/**
+ * Kernel-buffered input for terminals, in canonical (line) mode.
+ *
+ * Once a process has read from a terminal, its receiver is kept busy by the
+ * kernel: each received character is stored in the receive ring of the
+ * terminal by the interrupt handler and a new receive command is issued at
+ * once, so input typed while nobody is reading is not lost. Receiving is
+ * suspended while the ring is full (or after an error) and resumed by the
+ * next read.
+ *
+ * The READLINE syscall returns a whole line (newline included) in one trap:
+ * the caller is blocked until a line is complete, unless the ring is full.
+ * The ring shares the I/O channel of the receiver with WAITIO, which is
+ * served in between two characters: once the receive in flight completes,
+ * the channel is handed to the process waiting for it and receiving into the
+ * ring resumes after its command has completed.
+ */
+
+/**
+ * Initializes the receive rings and registers the READLINE syscall.
+ *
+ * @attention This function must be called once at boot before dispatching any process.
+ */
+extern void input_init(void);
+
+/**
+ * Handles the completion of a command on the receiver of the given terminal:
+ * if it was a receive issued for the ring, the character is stored and the
+ * next receive is issued.
+ *
+ * @attention This function must be called inside the interrupt handler, otherwise is UB.
+ *
+ * @return true if the next receive has been issued (the channel is still owned by the ring),
+ *         false if the completion must be handled as usual (the ring is full, a receive
+ *         failed or a WAITIO is waiting for the channel).
+ */
+extern bool input_complete(devreg_t *device);
+
+/**
+ * Starts receiving into the ring of the given terminal if it has been enabled,
+ * it is not full and the I/O channel of the receiver is free.
+ * Devices other than terminals are ignored.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ */
+extern void input_start(devreg_t *device);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <core.h>
+
+/**
+ * Kernel info page.
+ *
+ * The kernel publishes here the identity and the times of the running process
+ * every time it gives the processor back to it (dispatch or resume), so that
+ * processes can get them without trapping into the kernel.
+ * The page is written by the kernel only: processes must access it read-only
+ * through KINFO_PAGE or, better, through the kinfo_* functions below.
+ *
+ * The fields are not updated atomically with respect to the reader, that may be
+ * preempted halfway: sequence changes on every update so that readers can retry
+ * until they get a consistent snapshot.
+ */
+struct KernelInfo {
+    u32 sequence;               // incremented on every update
+    const void *pid;            // identifier of the running process
+    const void *parentPid;      // identifier of its parent (NULL if none)
+    ticks64_t userTime;         // user time accumulated up to the latest resume
+    ticks64_t kernelTime;       // kernel time accumulated up to the latest resume
+    ticks64_t startTime;        // TOD at which the process has been dispatched the first time
+    ticks_t resumeTimer;        // interval timer value at the latest resume
+};
+
+extern struct KernelInfo kinfo_page;
+
+// read-only view of the kernel info page
+#define KINFO_PAGE      ((const volatile struct KernelInfo *) &kinfo_page)
+
+/**
+ * Publishes the identity and the times of the process that is about to be
+ * (re)loaded on the processor.
+ *
+ * @attention This function must be called by the kernel only, otherwise is UB.
+ */
+extern void kinfo_publish(const void *pid, const void *parentPid,
+                          ticks64_t userTime, ticks64_t kernelTime, ticks64_t startTime, ticks_t resumeTimer);
+
+/**
+ * Same as GETPID without trapping: returns the identifier of the running process.
+ */
+extern const void *kinfo_getPid(void);
+
+/**
+ * Same as GETPID without trapping: returns the identifier of the parent of the running process.
+ */
+extern const void *kinfo_getParentPid(void);
+
+/**
+ * Same as GETCPUTIME without trapping: the user time includes the portion of the
+ * current slice elapsed so far and the wallclock time is computed from the TOD.
+ * NULL pointers are ignored.
+ */
+extern void kinfo_getCpuTime(ticks_t *userTime, ticks_t *kernelTime, ticks_t *wallclockTime);
+
+/**
+ * Same as GETCPUTIME64 without trapping, see kinfo_getCpuTime.
+ */
+extern void kinfo_getCpuTime64(ticks64_t *userTime, ticks64_t *kernelTime, ticks64_t *wallclockTime);
@@ -5,6 +5,7 @@
 /**
  * Clears the memory starting from ptr for the following len bytes,
  * setting each of them to zero.
+ * The bulk of the buffer is cleared a word at a time, in unrolled blocks.
  *
  * @attention (ptr == NULL) is a checked runtime error.
  */
@@ -12,6 +13,9 @@ extern void memclr(void *ptr, usize len);
 
 /**
  * Copies memory from source to destination for len bytes.
+ * When source and destination share the same alignment modulo the word size
+ * the bulk of the copy is done a word at a time, in unrolled blocks,
+ * otherwise it falls back to a byte-wise copy.
  *
  * @attentiont memory must NOT overlap!
  *
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <core.h>
+
+// size of the output queue of each device (a power of two), which is also the size limit of a print job
+#define OUTPUT_QUEUE_SIZE   256U
+
+// number of print jobs that can be queued on each printer (a power of two)
+#define OUTPUT_JOBS_NO      8U
+
+/**
+ * Kernel-buffered output for terminals and printers.
+ *
+ * The WRITE syscall copies a buffer into the output queue of a terminal
+ * transmitter or of a printer and returns at once: the characters are sent
+ * one at a time by the interrupt handler, as each of them completes.
+ * The caller is blocked only if the queue is full, until it drains to half of
+ * its size.
+ *
+ * The queues share the I/O channels of the devices with WAITIO: a queue that
+ * is being drained keeps its channel until it is empty, and it gets the channel
+ * back before any WAITIO waiting for it, so the characters written before a
+ * WAITIO on the same terminal are sent before its command. WAITIO on a printer
+ * whose queue is not empty is refused, since its data0 register belongs to the
+ * queue until then.
+ *
+ * The SPOOL syscall submits a print job to the printer spooler: the job is
+ * copied into the queue of the installed printer with the fewest characters
+ * queued that can take it whole, so that several jobs keep all the printers
+ * busy in parallel. The submitter continues at once (it is blocked only if no
+ * printer can take the job) and the optional semaphore of the job is signaled
+ * once its last character has been printed.
+ *
+ * Transmission errors can not be reported to the writer: the character is
+ * dropped and the queue goes on.
+ */
+
+/**
+ * Initializes the output queues and registers the WRITE and SPOOL syscalls.
+ *
+ * @attention This function must be called once at boot before dispatching any process.
+ */
+extern void output_init(void);
+
+/**
+ * Handles the completion of a command on the given device: if it was a character
+ * of its output queue and more are waiting, the next one is sent.
+ *
+ * @attention This function must be called inside the interrupt handler, otherwise is UB.
+ *
+ * @return true if the next character has been sent (the channel is still owned by the queue),
+ *         false if the completion must be handled as usual.
+ */
+extern bool output_complete(devreg_t *device);
+
+/**
+ * Tells whether the output queue of the given device has characters left to send.
+ * Devices without output queue have none.
+ */
+extern bool output_pending(const devreg_t *device);
+
+/**
+ * Starts draining the output queue of the given device if it is not empty and
+ * its I/O channel is free. Devices without output queue are ignored.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ */
+extern void output_start(devreg_t *device);
@@ -4,25 +4,60 @@
 #include <listx.h>
 #include <core.h>
 
-// Process Control Block (PCB) data structure
-typedef struct pcb_t {
-    // processor state
-    cpustate_t p_s;
-
-    // process queue fields
-    struct list_head p_next;
-
-    // process tree fields
-    struct list_head p_child, p_sib;
-    struct pcb_t *p_parent;
+// Queue on which a process currently is
+enum PcbQueue {
+    PcbQueue_None = 0,      // allocated but not yet in any queue
+    PcbQueue_Free = 1,      // in the free list
+    PcbQueue_Ready = 2,     // in the ready queue
+    PcbQueue_Running = 3,   // the current process
+    PcbQueue_Blocked = 4,   // in the queue of the semaphore p_semkey
+    PcbQueue_Sleeping = 5,  // in the sleep queue until wakeup_time
+};
 
-    // custom handlers
+/**
+ * Passup descriptor: the custom handlers of a process.
+ * Only the processes which register a custom handler own one (see allocPassup).
+ */
+typedef struct passup_t {
     cpustate_t *sysbkHandler;
     cpustate_t *sysbkOldArea;
     cpustate_t *TLBHandler;
     cpustate_t *TLBOldArea;
     cpustate_t *trapHandler;
     cpustate_t *trapOldArea;
+} passup_t;
+
+/**
+ * Cold part of the Process Control Block: it is touched only when the process
+ * is loaded, saved or passes up an exception, so it is kept apart from the
+ * scheduling state (see pcbCold).
+ */
+typedef struct pcb_cold_t {
+    // processor state
+    cpustate_t p_s;
+
+    // custom handlers, NULL until the process registers the first one
+    struct passup_t *p_passup;
+} pcb_cold_t;
+
+/**
+ * Process Control Block (PCB) data structure.
+ *
+ * It holds only the (hot) scheduling state: PCBs are kept in a compact array,
+ * next to the array of their cold parts, both indexed by PID.
+ */
+typedef struct pcb_t {
+    // process queue fields
+    struct list_head p_next;
+
+    // the current priority of the process: original_priority + aging
+    int priority;
+
+    // epoch of the ready queue at which the process started waiting (see readyq.h)
+    u32 enqueue_epoch;
+
+    // queue on which the process is: tells how to remove it without searching
+    enum PcbQueue p_queue;
 
     // key of the semaphore on which the process is eventually blocked
     int *p_semkey;
@@ -30,21 +65,51 @@ typedef struct pcb_t {
     // priority defined when creating a process
     int original_priority;
 
-    // the current priority of the process: original_priority + aging
-    int priority;
+    // process tree fields
+    struct list_head p_child;   // list of the children (sentinel), linked through their p_sib
+    struct list_head p_sib;     // node in the list of the children of p_parent
+    struct pcb_t *p_parent;
+    usize p_childCount;         // number of nodes in p_child
 
     // process execution times
-    ticks_t start_time;             // TODLow when process runs for the first time; used to calculate the wallclock time
-    ticks_t user_time;              // self-explained
-    ticks_t kernel_time;            // self-explained
-    ticks_t latest_handler_time;    // sample of timer at the moment of the termination of the last call to a handler
+    bool started;                   // true once the process has been dispatched, start_time is meaningful from then on
+    ticks64_t start_time;           // TOD when process runs for the first time; used to calculate the wallclock time
+    ticks64_t user_time;            // self-explained
+    ticks64_t kernel_time;          // self-explained
+    ticks_t latest_handler_time;    // value of the interval timer (in clock ticks) when the process was last resumed
+    ticks_t wakeup_time;            // TODLow at which the process stops sleeping (see sleepq.h)
 } pcb_t;
 
-// free list handling functions
+/**
+ * Free list handling functions.
+ *
+ * PCBs are carved in slabs out of the free RAM on demand (see slab.h):
+ * allocPcb returns NULL only when the free RAM is exhausted.
+ * The processor state of a newly allocated pcb is left uninitialized.
+ */
 void initPcbs(void);
 void freePcb(struct pcb_t *p);
 struct pcb_t *allocPcb(void);
 
+/**
+ * Returns the cold part (processor state and custom handlers) of a pcb.
+ *
+ * @attention (NULL == p) is a checked runtime error.
+ * @attention p must have been returned by allocPcb otherwise is UB.
+ */
+struct pcb_cold_t *pcbCold(const struct pcb_t *p);
+
+/**
+ * Attaches a cleared passup descriptor to p; it is released by freePcb.
+ * Descriptors are carved in slabs out of the free RAM on demand.
+ *
+ * @attention (NULL == p) is a checked runtime error.
+ * @attention p must not own a passup descriptor yet, otherwise is CRE.
+ *
+ * @return the descriptor or NULL if the free RAM is exhausted.
+ */
+struct passup_t *allocPassup(struct pcb_t *p);
+
 // queue handling functions
 void mkEmptyProcQ(struct list_head *head);
 int emptyProcQ(struct list_head *head);
@@ -53,12 +118,56 @@ struct pcb_t *headProcQ(struct list_head *head);
 struct pcb_t *removeProcQ(struct list_head *head);
 struct pcb_t *outProcQ(struct list_head *head, struct pcb_t *p);
 
-// tree view functions
+/**
+ * Tree view functions.
+ *
+ * Each process keeps the list of its children (in insertion order) and
+ * its own node in the list of its siblings, so every function below is O(1).
+ */
 int emptyChild(struct pcb_t *root);
 void insertChild(struct pcb_t *root, struct pcb_t *p);
 struct pcb_t *removeChild(struct pcb_t *root);
 struct pcb_t *outChild(struct pcb_t *child);
 
+/**
+ * Returns the first child of root, NULL if root has no children.
+ *
+ * @attention (NULL == root) is a checked runtime error.
+ */
+struct pcb_t *firstChild(struct pcb_t *root);
+
+/**
+ * Returns the sibling that follows (respectively precedes) p among the
+ * children of its parent, NULL if p is the last (respectively first) child
+ * or has no parent.
+ *
+ * @attention (NULL == p) is a checked runtime error.
+ */
+struct pcb_t *nextSibling(struct pcb_t *p);
+struct pcb_t *prevSibling(struct pcb_t *p);
+
+/**
+ * Post-order traversal of the sub-tree rooted in root: every process is
+ * visited after all of its descendants and root is visited last.
+ * The traversal follows the parent links instead of recursing, thus it takes
+ * constant stack space and linear time in the number of visited processes.
+ *
+ *     for (node = firstPostOrder(root); NULL != node; node = next) {
+ *         next = nextPostOrder(root, node);
+ *         ...
+ *     }
+ *
+ * Visited processes can be removed from their queues or freed, as long as the
+ * tree links (p_child, p_sib and p_parent) are left untouched until the end.
+ *
+ * @attention (NULL == root) or (NULL == node) is a checked runtime error.
+ * @attention node must belong to the sub-tree rooted in root otherwise is UB.
+ *
+ * @return the first (respectively next) process to visit, NULL after root.
+ */
+struct pcb_t *firstPostOrder(struct pcb_t *root);
+struct pcb_t *nextPostOrder(struct pcb_t *root, struct pcb_t *node);
+
 /**
  * Returns the process control block identifier.
  * The PID is unique and is > 0.
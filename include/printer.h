@@ -27,3 +27,18 @@ extern bool printer_putchar(unsigned handle, char character);
  * @return The number of characters correctly transmitted.
  */
 extern usize printer_puts(unsigned handle, const char *str);
+
+/**
+ * Submits a print job to the printer spooler and returns without waiting for it to be printed.
+ * The spooler prints the job on the installed printer with the shortest queue, so that
+ * several jobs are printed in parallel; the caller is blocked only if no printer can take
+ * the job right away.
+ *
+ * @attention The buffer is copied, so it can be reused as soon as this function returns.
+ *
+ * @param buf The characters to be printed.
+ * @param len The number of characters, at most OUTPUT_QUEUE_SIZE.
+ * @param semaphore The semaphore signaled once the job has been printed, can be NULL.
+ * @return The handle of the printer the job has been queued on, or -1 if the job has been rejected.
+ */
+extern int printer_spool(const char *buf, usize len, int *semaphore);
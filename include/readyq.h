@@ -0,0 +1,70 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <listx.h>
+#include <pcb.h>
+
+// number of priority levels handled by the ready queue
+#define READYQ_LEVELS   32
+
+/**
+ * Ready queue (READYQ) data structure.
+ *
+ * Processes are kept in one FIFO bucket per priority level; a bitmap keeps
+ * track of the non-empty buckets so that the highest priority process can be
+ * found with a count-leading-zeros, thus every operation is O(1) regardless
+ * of the number of ready processes.
+ *
+ * Priorities are clamped into [0, READYQ_LEVELS - 1]: processes whose priority
+ * is beyond the bounds share the same (first or last) bucket in FIFO order.
+ *
+ * Aging is lazy: each process records the epoch at which it has been enqueued
+ * and its effective priority is derived as priority + (epoch - enqueue_epoch).
+ * The buckets are a ring indexed by (level - epoch), so advancing the epoch
+ * raises every queued process by one level without rewriting any entry.
+ */
+typedef struct readyq_t {
+    // number of agings performed so far (wraps around)
+    u32 epoch;
+
+    // bit i is set iff buckets[i] is not empty
+    u32 bitmap;
+
+    // FIFO of the processes for each priority level, rotated by epoch
+    struct list_head buckets[READYQ_LEVELS];
+} readyq_t;
+
+// ready queue handling functions
+void mkEmptyReadyQ(struct readyq_t *q);
+int emptyReadyQ(const struct readyq_t *q);
+void insertReadyQ(struct readyq_t *q, struct pcb_t *p);
+struct pcb_t *headReadyQ(const struct readyq_t *q);
+struct pcb_t *removeReadyQ(struct readyq_t *q);
+
+/**
+ * Removes the specified process from the ready queue.
+ *
+ * @attention (NULL == q) or (NULL == p) is a checked runtime error.
+ * @attention p must be in q otherwise is UB.
+ *
+ * @return p.
+ */
+struct pcb_t *outReadyQ(struct readyq_t *q, struct pcb_t *p);
+
+/**
+ * Ages every process in the queue by one priority level advancing the epoch.
+ * Runs in O(1) without touching any process.
+ *
+ * @attention (NULL == q) is a checked runtime error.
+ */
+void ageReadyQ(struct readyq_t *q);
+
+/**
+ * Returns the priority obtained aging the given one for elapsed epochs.
+ * Since every priority beyond the top level shares the same bucket,
+ * the result saturates as soon as the top level is reached.
+ *
+ * @param priority The priority when the process started waiting.
+ * @param elapsed  The number of epochs the process has been waiting for (epoch - enqueue_epoch).
+ */
+int agePriority(int priority, u32 elapsed);
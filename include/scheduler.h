@@ -4,9 +4,36 @@
 #include <const_bikaya.h>
 #include <primitive_types.h>
 
-// time slice in microseconds
+// time slice in microseconds; armed only while at least two processes are runnable
 #define TIME_SLICE  3000
 
+// number of I/O channels: one for each device plus one for each terminal receiver
+#define IO_CHANNEL_NO   ((INTERRUPT_LINE_TERMINAL - INTERRUPT_LINE_DISK + 1) * MACHINE_DEVICE_PER_LINE_NO + MACHINE_DEVICE_TERMINAL_NO)
+
+/**
+ * Returns the I/O channel of a device: channels are numbered as the device
+ * registers, followed by the terminal receivers.
+ *
+ * @attention device must be the register of a device (from disks to terminals) otherwise is UB.
+ *
+ * @param device The register of the device.
+ * @param receiver Whether the channel is the receiver of a terminal, rather than the device (or transmitter) itself.
+ */
+static inline unsigned scheduler_ioChannel(const devreg_t *const device, const bool receiver) {
+    const devreg_t *const firstDevice = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_DISK, 0);
+    const devreg_t *const firstTerm = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0);
+
+    return receiver ? (unsigned) (IO_CHANNEL_NO - MACHINE_DEVICE_TERMINAL_NO + (device - firstTerm))
+                    : (unsigned) (device - firstDevice);
+}
+
+/**
+ * Initializes the scheduler data structures.
+ *
+ * @attention This function must be called once at boot before scheduling any process.
+ */
+extern void scheduler_init(void);
+
 /**
  * Schedules a process with a given priority.
  *
@@ -29,16 +56,22 @@ extern bool scheduler_scheduleWith(void (*process)(void), int priority, bool int
 extern int scheduler_scheduleChild(const cpustate_t *childState, int priority, const void **childPid);
 
 /**
- * Runs the first process waiting in the ready queue. If the ready queue is empty,
- * it halts the machine.
+ * Runs the first process waiting in the ready queue. If the ready queue is empty
+ * but some process is blocked or sleeping, the processor waits (with device interrupts
+ * enabled and the interval timer armed only for the next sleeper) for an interrupt;
+ * if nothing is either ready or blocked, it halts the machine.
+ *
+ * The interval timer is programmed to the end of the time slice or to the next
+ * event of the sleep queue, whichever comes first (see scheduler_sliceExpired).
  *
  * @attention There must be no running process or else is CRE.
  */
 extern void scheduler_dispatch(void);
 
 /**
- * Stops the current process saving its state and starts another process
- * (or halts the machine) following the scheduling policy.
+ * Stops the current process and starts another process (or halts the machine)
+ * following the scheduling policy. The state of the stopped process is copied
+ * into its PCB only if another process is dispatched in its place.
  * 
  * @attention This function must be called inside a handler, otherwise is UB.
  * @attention There must be a running process or else is CRE.
@@ -53,6 +86,8 @@ extern void scheduler_contextSwitch(cpustate_t *procState, ticks_t timeLeft, tic
 
 /**
  * Updates timeInfo of the current process and resumes it.
+ * If in the meantime a process with higher priority has become ready,
+ * the current process is preempted and the other one is dispatched instead.
  *
  * @attention This function must be called inside a handler, otherwise is UB.
  * @attention There must be a running process or else is CRE.
@@ -65,19 +100,50 @@ extern void scheduler_contextSwitch(cpustate_t *procState, ticks_t timeLeft, tic
  */
 extern void scheduler_resume(cpustate_t *procState, ticks_t timeLeft, ticks_t handlerTime, struct TimeInfo *timeInfo);
 
+/**
+ * Tells whether the current process can be resumed with scheduler_resumeFast:
+ * no process that outranks it has become ready and, if any other process is
+ * ready, its time slice is already armed. This holds after every system call
+ * that neither blocked the caller nor made ready another process (e.g. an
+ * uncontended VERHOGEN or PASSEREN).
+ */
+extern bool scheduler_canResumeFast(void);
+
+/**
+ * Same as scheduler_resume, but for handlers that have not reset the interval timer
+ * on entry, so that the time slice of the current process kept running meanwhile:
+ * the time spent in the handler is charged as kernel time and the timer is left
+ * untouched (unless it expired in the meantime).
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention Calling it when scheduler_canResumeFast() is false is CRE.
+ * @attention There must be a running process or else is CRE.
+ * @attention procState == NULL is CRE.
+ * @attention passing a state different from the current process' one is UB.
+ *
+ * @param procState The most updated state of the current process (obtained inside the handler).
+ * @param timeLeft The value of the interval timer on entry of the handler.
+ * @param timeInfo Where to store the times of the current process (if not NULL).
+ */
+extern void scheduler_resumeFast(cpustate_t *procState, ticks_t timeLeft, struct TimeInfo *timeInfo);
+
 /**
  * Deallocates the specified process and its progeny.
  * If NULL == pid, it drops the current process.
  *
  * @attention This function must be called inside a handler, otherwise is UB.
- * @attention NULL == procState is CRE.
  * @attention NULL == pid and no current process is CRE.
  * @attention If after this call the current process is dropped, then scheduler_dispatch() is called.
  *
  * @param pid The identifier of the process to drop.
- * @param procState The most updated state of the current process (obtained inside the handler). 
  */
-extern void scheduler_drop(void *pid, cpustate_t *procState);
+extern void scheduler_drop(void *pid);
+
+/**
+ * Returns the total time (in clock ticks) the processor has spent waiting
+ * for an interrupt because no process was ready.
+ */
+extern usize scheduler_getIdleTime(void);
 
 /**
  * Returns the process identifier of the current process.
@@ -166,10 +232,107 @@ extern void scheduler_callTrapHandler(cpustate_t *procState, ticks_t timeLeft, t
 extern void scheduler_passeren(int *semaphoreKey, cpustate_t *procState, ticks_t timeLeft, ticks_t handlerTime);
 
 /**
- * Performs the verhogen on the specified semaphore. 
+ * Puts the current process to sleep for the given number of clock ticks and dispatches another process.
+ * The process is made ready by scheduler_wakeSleepers as soon as the delay has elapsed.
  *
  * @attention This function must be called inside a handler, otherwise is UB.
- * @attention NULL == semaphoreKey is CRE.
  * @attention There must be a running process or else is CRE.
+ * @attention ticks must be in [1, SLEEPQ_MAX_DELAY] otherwise is CRE.
+ *
+ * @param ticks The delay in clock ticks.
+ * @param procState The most updated state of the current process (obtained inside the handler).
+ * @param timeLeft The remaining part of the time slice for the current process (obtained inside the handler).
+ * @param handlerTime The time spent inside the handler
+ */
+extern void scheduler_sleep(ticks_t ticks, cpustate_t *procState, ticks_t timeLeft, ticks_t handlerTime);
+
+/**
+ * Makes ready the sleeping processes whose delay has elapsed.
+ * It is meant to be called on the interrupt of the interval timer, even while the processor is idle.
+ */
+extern void scheduler_wakeSleepers(void);
+
+/**
+ * Returns true if the time slice of the current process is over. Since the interval
+ * timer is raised by the sleep queue as well, its interrupt alone does not tell.
+ */
+extern bool scheduler_sliceExpired(void);
+
+/**
+ * Performs the verhogen on the specified semaphore.
+ * It can be called while the processor is idle as well (e.g. on device completion).
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention NULL == semaphoreKey is CRE.
  */
 extern void scheduler_verhogen(int *semaphoreKey);
+
+/**
+ * Wakes up every process blocked on the specified semaphore, leaving its value untouched.
+ * Like scheduler_verhogen it can be called while the processor is idle.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention NULL == semaphoreKey is CRE.
+ */
+extern void scheduler_wakeAll(int *semaphoreKey);
+
+/**
+ * Reserves the given I/O channel for the current process if no command is in flight on it.
+ * On success the caller must issue the command of the current process to the device.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention channel >= IO_CHANNEL_NO is CRE.
+ * @attention There must be a running process or else is CRE.
+ *
+ * @return true if the channel has been reserved, false if it is busy.
+ */
+extern bool scheduler_startIO(unsigned channel);
+
+/**
+ * Reserves the given I/O channel for the kernel itself if no command is in flight on it.
+ * On success the caller must issue its own command to the device: on completion
+ * nobody is woken up (see scheduler_completeIO).
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention channel >= IO_CHANNEL_NO is CRE.
+ *
+ * @return true if the channel has been reserved, false if it is busy.
+ */
+extern bool scheduler_startKernelIO(unsigned channel);
+
+/**
+ * Returns true if some process is waiting (WAITIO) for the given I/O channel to be free,
+ * so that the kernel can give the channel back to it rather than reserving it again.
+ *
+ * @attention channel >= IO_CHANNEL_NO is CRE.
+ */
+extern bool scheduler_hasIOWaiters(unsigned channel);
+
+/**
+ * Blocks the current process until the completion of its command on the given I/O channel,
+ * then dispatches another process.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention channel >= IO_CHANNEL_NO is CRE.
+ * @attention There must be a running process or else is CRE.
+ *
+ * @param channel The I/O channel.
+ * @param procState The most updated state of the current process (obtained inside the handler).
+ * @param timeLeft The remaining part of the time slice for the current process (obtained inside the handler).
+ * @param handlerTime The time spent inside the handler
+ */
+extern void scheduler_waitIO(unsigned channel, cpustate_t *procState, ticks_t timeLeft, ticks_t handlerTime);
+
+/**
+ * Completes the command in flight on the given I/O channel: the process that issued it
+ * (if still alive) is woken up and gets status as return value of its WAITIO.
+ * Unless handOver is set, the channel is left free rather than being passed on to the
+ * next process waiting for it, so that the kernel can reserve it for itself.
+ *
+ * @attention This function must be called inside a handler, otherwise is UB.
+ * @attention channel >= IO_CHANNEL_NO is CRE.
+ *
+ * @return The state of the next process waiting for the channel, whose command (first syscall argument)
+ *         must be issued by the caller, or NULL if nobody is waiting (or !handOver).
+ */
+extern const cpustate_t *scheduler_completeIO(unsigned channel, unsigned status, bool handOver);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <primitive_types.h>
+
+// size (and alignment) in bytes of each slab
+#define SLAB_SIZE   4096U
+
+/**
+ * Carves a new slab out of the free RAM between the end of the kernel image
+ * and the process stacks.
+ *
+ * The free RAM is shared by two regions growing one toward the other:
+ * slabs are allocated upwards starting from the end of the kernel image,
+ * while process stacks grow downwards from the RAM limit (one stack frame
+ * of MACHINE_STACK_SIZE bytes for each PID, plus one for the kernel).
+ * Since each slab of PCBs brings new PIDs, the caller tells how many stack
+ * frames must be reserved along with the slab, so that the two regions can
+ * never overlap.
+ *
+ * Slabs are never given back.
+ *
+ * @param stackFramesNo The number of stack frames to reserve along with the slab.
+ *
+ * @return the address of a SLAB_SIZE aligned block of SLAB_SIZE bytes or NULL
+ *         if there is not enough free RAM left.
+ */
+extern void *slab_carve(usize stackFramesNo);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <listx.h>
+#include <core.h>
+#include <pcb.h>
+
+// number of slots of each level of the timer wheel (the bitmap of a level is a single u32)
+#define SLEEPQ_SLOTS        32
+
+// number of levels of the timer wheel: each level spans SLEEPQ_SLOTS times the previous one
+#define SLEEPQ_LEVELS       6
+
+// longest delay (in clock ticks) a process can sleep for: the span of the whole wheel
+#define SLEEPQ_MAX_DELAY    ((1U << (5 * SLEEPQ_LEVELS)) - 1U)
+
+/**
+ * Sleep queue (SLEEPQ) data structure: a hierarchical timer wheel of sleeping processes.
+ *
+ * Each process is kept in a slot of the level whose span covers its delay:
+ * level 0 has one slot per clock tick, the slots of level l span 32^l ticks.
+ * A slot of level l > 0 is cascaded (its processes are spread over the lower
+ * levels) once the wheel reaches its first tick, so each process is moved at
+ * most SLEEPQ_LEVELS times before it expires: inserting and removing a process
+ * are O(1) and expiring it is amortized O(1) regardless of the number of sleepers.
+ *
+ * A bitmap per level keeps track of the non-empty slots, so that the next event
+ * of the wheel (the first tick at which something has to be expired or cascaded)
+ * is found without walking empty slots.
+ *
+ * Times are TOD values: they wrap around, thus they are compared by difference.
+ */
+typedef struct sleepq_t {
+    // TOD up to which the wheel has been advanced
+    ticks_t now;
+
+    // bit s of bitmaps[l] is set iff slots[l][s] is not empty
+    u32 bitmaps[SLEEPQ_LEVELS];
+
+    // processes waiting for a tick of each slot, linked through their p_next
+    struct list_head slots[SLEEPQ_LEVELS][SLEEPQ_SLOTS];
+} sleepq_t;
+
+/**
+ * Initializes an empty sleep queue whose wheel starts at now.
+ *
+ * @attention (NULL == q) is a checked runtime error.
+ */
+void mkEmptySleepQ(struct sleepq_t *q, ticks_t now);
+
+int emptySleepQ(const struct sleepq_t *q);
+
+/**
+ * Inserts a process that wakes up at the given TOD.
+ *
+ * @attention (NULL == q) or (NULL == p) is a checked runtime error.
+ * @attention wakeup must follow q->now by [1, SLEEPQ_MAX_DELAY] ticks, otherwise is CRE.
+ */
+void insertSleepQ(struct sleepq_t *q, struct pcb_t *p, ticks_t wakeup);
+
+/**
+ * Advances the wheel up to now and removes one of the processes whose wakeup is due.
+ * It is meant to be called until it returns NULL, which leaves the wheel at now
+ * (an empty one is moved there even if it has been left behind by more than 2^31 ticks).
+ *
+ * @attention (NULL == q) is a checked runtime error.
+ *
+ * @return an expired process or NULL if none is left.
+ */
+struct pcb_t *removeSleepQ(struct sleepq_t *q, ticks_t now);
+
+/**
+ * Removes the specified process from the sleep queue before its wakeup.
+ *
+ * @attention (NULL == q) or (NULL == p) is a checked runtime error.
+ * @attention p must be in q otherwise is UB.
+ *
+ * @return p.
+ */
+struct pcb_t *outSleepQ(struct sleepq_t *q, struct pcb_t *p);
+
+/**
+ * Returns the TOD of the next event of the wheel: it is the wakeup of a process
+ * or a tick at which the wheel has to be advanced to get closer to one, so it
+ * never follows the earliest wakeup.
+ *
+ * @attention q must not be empty otherwise is CRE.
+ */
+ticks_t nextEventSleepQ(const struct sleepq_t *q);
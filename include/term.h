@@ -7,6 +7,9 @@
  * The character is intended to be a valid ASCII character (range [0, 127]),
  * internally the character is converted to an unsigned char.
  *
+ * Note: output is buffered by the kernel (see output.h): success means
+ *       that the character has been queued for transmission.
+ *
  * @attention Passing an invalid handle is a checked runtime error.
  * @attention Passing a character with value outside range [0, 127] is UB.
  *
@@ -28,13 +31,28 @@ extern bool term_putchar(unsigned handle, char character);
  *
  * @param handle The terminal handle.
  * @param str The string to be transmitted.
- * @return The number of characters correctly transmitted.
+ * @return The number of characters queued for transmission.
  */
 extern usize term_puts(unsigned handle, const char *str);
 
+/**
+ * Prints the first len characters of buf, with a single WRITE syscall as long
+ * as they fit in the output queue of the terminal.
+ * If buf is NULL this function will result in noop returning 0.
+ *
+ * @attention passing an invalid handle is a checked runtime error.
+ *
+ * @param handle The terminal handle.
+ * @param buf The characters to be transmitted.
+ * @param len The number of characters to be transmitted.
+ * @return The number of characters queued for transmission.
+ */
+extern usize term_write(unsigned handle, const char *buf, usize len);
+
 /**
  * Reads a character from the terminal and stores it into the specified buffer.
- * This function is blocking and will wait for user input.
+ * This function is blocking and will wait for user input: input is line
+ * buffered by the kernel (see input.h), so it waits for a whole line to be typed.
  * If the buffer is NULL the character read will be discarded.
  *
  * @attention passing an invalid handle is a checked runtime error.
@@ -52,6 +70,7 @@ extern bool term_getchar(unsigned handle, char *buf);
  * until (n-1) characters have been read or either termination is reached,
  * whichever happens first.
  * This function is blocking and will wait for user input.
+ * With the default termination (newline) the line is read with a single syscall.
  * If the buffer is NULL the characters read will be discarded.
  *
  * Note: Calling this function with
@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * Fields of the uARM processor state used by the accessors of hal.h.
+ * Do not include this header directly, include core.h instead.
+ */
+
+#define STATE_PC_FIELD          pc
+#define STATE_SP_FIELD          sp
+#define STATE_SYSNO_FIELD       a1
+#define STATE_ARG1_FIELD        a2
+#define STATE_ARG2_FIELD        a3
+#define STATE_ARG3_FIELD        a4
+#define STATE_RETURN_FIELD      a1
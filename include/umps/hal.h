@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * Fields of the uMPS processor state used by the accessors of hal.h.
+ * Do not include this header directly, include core.h instead.
+ */
+
+#define STATE_PC_FIELD          pc_epc
+#define STATE_SP_FIELD          reg_sp
+#define STATE_SYSNO_FIELD       reg_a0
+#define STATE_ARG1_FIELD        reg_a1
+#define STATE_ARG2_FIELD        reg_a2
+#define STATE_ARG3_FIELD        reg_a3
+#define STATE_RETURN_FIELD      reg_v0
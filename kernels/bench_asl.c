@@ -0,0 +1,69 @@
+/**
+ * Measures the cost of a contended V/P pair on the ASL (removeBlocked plus
+ * insertBlocked on a random active semaphore) sweeping the number of active
+ * semaphores over 16, 128, 1024 and 4096.
+ *
+ * Results are printed on terminal 0 in clock ticks per operation pair.
+ *
+ * Note: the hash table of the ASL is sized for MAX_SEM_NO active semaphores,
+ *       configure with -DMAX_SEM_NO=4096 to keep the load factor below 1 over
+ *       the whole sweep. The process pool takes about 1 MiB of RAM, so the
+ *       emulator must be configured with at least 2 MiB of RAM.
+ */
+
+#include <primitive_types.h>
+#include <helpers.h>
+#include <core.h>
+#include <pcb.h>
+#include <asl.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_MAX_SEM   4096
+#define BENCH_ROUNDS    1000
+
+static struct pcb_t pool[BENCH_MAX_SEM];
+static int semaphores[BENCH_MAX_SEM];
+static u32 seed = 1;
+
+static ticks_t aslRound(const usize n) {
+    for (usize i = 0; i < n; ++i) {
+        pool[i].p_semkey = NULL;
+        insertBlocked(&semaphores[i], &pool[i]);
+    }
+
+    seed = 1;
+    const ticks_t start = machine_getTODLow();
+
+    for (usize i = 0; i < BENCH_ROUNDS; ++i) {
+        int *const key = &semaphores[u32_random(&seed, (u32) n)];
+        struct pcb_t *const proc = removeBlocked(key);
+        insertBlocked(key, proc);
+    }
+
+    const ticks_t elapsed = machine_getTODLow() - start;
+
+    for (usize i = 0; i < n; ++i) {
+        removeBlocked(&semaphores[i]);
+    }
+
+    return elapsed / BENCH_ROUNDS;
+}
+
+static void bench(void) {
+    static const usize sizes[] = { 16, 128, 1024, BENCH_MAX_SEM };
+
+    // the scheduler uses the ASL as well: the measurements start from a clean one.
+    initASL();
+
+    for (usize i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        bench_report("semaphores=", sizes[i], " ");
+        bench_report("asl=", aslRound(sizes[i]), " ticks/op\n");
+    }
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,49 @@
+/**
+ * Measures the cost of a dispatch: two processes hand the CPU over to each
+ * other blocking on a semaphore and waking up the other one, so that every
+ * handoff is a VERHOGEN, a PASSEREN which blocks the caller and a dispatch.
+ *
+ * On uMPS the TOD clock advances once per processor cycle, thus the result,
+ * printed on terminal 0 in clock ticks per handoff, is also the number of
+ * instructions executed per dispatch (syscall entry and exit included).
+ */
+
+#include <primitive_types.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_ROUNDS    1000
+
+static int pingSem = 0;
+static int pongSem = 0;
+
+static void ponger(void) {
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &pingSem, 0, 0);
+        SYSCALL(VERHOGEN, (memaddr) &pongSem, 0, 0);
+    }
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void pinger(void) {
+    const ticks_t start = machine_getTODLow();
+
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(VERHOGEN, (memaddr) &pingSem, 0, 0);
+        SYSCALL(PASSEREN, (memaddr) &pongSem, 0, 0);
+    }
+
+    const ticks_t elapsed = machine_getTODLow() - start;
+
+    // each round is made of two handoffs
+    bench_report("dispatch: ", elapsed / (2 * BENCH_ROUNDS), " ticks/handoff\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=pinger, .priority=1, .copies=1 },
+    { .entry=ponger, .priority=1, .copies=1 }
+)
@@ -0,0 +1,48 @@
+/**
+ * Measures the round trip of the GETPID syscall, the cheapest one, which is
+ * dominated by the cost of entering and leaving the kernel, and the ones of
+ * uncontended VERHOGEN and PASSEREN (nobody blocked, nobody to block).
+ *
+ * The emulated TOD clocks advance once per processor cycle, thus the result,
+ * printed on terminal 0 in clock ticks per syscall, is also the number of
+ * instructions executed per round trip on both uMPS and uARM.
+ */
+
+#include <primitive_types.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_ROUNDS    1000
+
+static int semaphore = 0;
+
+static void bench(void) {
+    const void *pid = NULL;
+    ticks_t start;
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(GETPID, (memaddr) &pid, 0, 0);
+    }
+    bench_report("GETPID: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/syscall\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(VERHOGEN, (memaddr) &semaphore, 0, 0);
+    }
+    bench_report("VERHOGEN: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/syscall\n");
+
+    // the verhogens above leave enough resources for each passeren
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &semaphore, 0, 0);
+    }
+    bench_report("PASSEREN: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/syscall\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
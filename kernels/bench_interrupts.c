@@ -0,0 +1,52 @@
+/**
+ * One process per terminal prints the same text at once, so that the
+ * completions of the terminals pile up; once all of them are done the number
+ * of interrupt exceptions and of device interrupts acknowledged is printed on
+ * terminal 0, together with the devices serviced by each entry.
+ *
+ * Note: the emulator must be configured with BENCH_TERMINALS terminals.
+ */
+
+#include <primitive_types.h>
+#include <term.h>
+#include <core.h>
+#include <handlers.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_TERMINALS     MACHINE_DEVICE_TERMINAL_NO
+
+static const char text[] =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n"
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam,\n";
+
+static int doneSem = 0;
+static unsigned nextTerminal = 0;
+
+static void printer(void) {
+    const unsigned terminal = nextTerminal++;
+
+    term_puts(terminal, text);
+
+    SYSCALL(VERHOGEN, (memaddr) &doneSem, 0, 0);
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void reporter(void) {
+    for (unsigned i = 0; i < BENCH_TERMINALS; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &doneSem, 0, 0);
+    }
+
+    const struct InterruptStats stats = *handlers_getInterruptStats();
+
+    bench_report("entries=", stats.entries, " ");
+    bench_report("devices=", stats.devices, " ");
+    bench_report("max devices/entry=", stats.maxDevices, "\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=printer, .priority=2, .interruptsEnabled=true, .copies=BENCH_TERMINALS },
+    { .entry=reporter, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
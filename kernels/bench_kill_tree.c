@@ -0,0 +1,87 @@
+/**
+ * Measures how long TERMINATEPROCESS takes to kill a tree of 500 processes,
+ * where each node spawns up to 4 children and then blocks on a semaphore:
+ * when the tree is complete, part of the nodes is blocked while the ones
+ * that have not run yet are still in the ready queue.
+ *
+ * The result is printed on terminal 0 in clock ticks.
+ *
+ * Note: each process takes a stack frame, so the emulator must be configured
+ *       with at least 1 MiB of RAM.
+ */
+
+#include <primitive_types.h>
+#include <helpers.h>
+#include <memory.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define TREE_SIZE           500
+#define TREE_FANOUT         4
+#define TREE_PRIORITY       1
+#define NODE_STACK_SIZE     256
+
+static u8 stacks[TREE_SIZE][NODE_STACK_SIZE] __attribute__((aligned(8)));
+static u32 created = 0;
+static int builtSem = 0;
+static int parkSem = 0;
+
+static void node(void);
+
+/**
+ * Creates a new node of the tree as child of the current process.
+ */
+static void spawn(void **const pid) {
+    cpustate_t state;
+
+    memclr(&state, sizeof(state));
+    state_update(&state, (struct StateConfig) {
+        .mode=CPU_MODE_KERNEL,
+        .fastInterruptsEnabled=true,
+        .interruptsEnabled=false,
+    });
+    *state_programCounter(&state) = (memaddr) node;
+    state_setStackPointer(&state, (memaddr) stacks[created] + NODE_STACK_SIZE);
+    created += 1;
+
+    if (0 != SYSCALL(CREATEPROCESS, (memaddr) &state, TREE_PRIORITY, (memaddr) pid)) {
+        trace("unable to create a process");
+        core_panic();
+    }
+}
+
+static void node(void) {
+    // Interrupts are disabled and nodes have the same priority, so nobody
+    // else runs in between: the last node created wakes up the benchmark.
+    for (usize i = 0; i < TREE_FANOUT && created < TREE_SIZE; ++i) {
+        spawn(NULL);
+
+        if (TREE_SIZE == created) {
+            SYSCALL(VERHOGEN, (memaddr) &builtSem, 0, 0);
+        }
+    }
+
+    SYSCALL(PASSEREN, (memaddr) &parkSem, 0, 0);
+    unreachable();
+}
+
+static void bench(void) {
+    void *root = NULL;
+
+    spawn(&root);
+    SYSCALL(PASSEREN, (memaddr) &builtSem, 0, 0);
+
+    const ticks_t start = machine_getTODLow();
+    SYSCALL(TERMINATEPROCESS, (memaddr) root, 0, 0);
+    const ticks_t elapsed = machine_getTODLow() - start;
+
+    bench_report("killed ", TREE_SIZE, " ");
+    bench_report("processes in ", elapsed, " ticks\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=TREE_PRIORITY + 10, .copies=1 }
+)
@@ -0,0 +1,69 @@
+/**
+ * Compares GETPID, GETCPUTIME and GETCPUTIME64 with their trap-free counterparts
+ * that read the kernel info page (see kinfo.h), checking that both give the same answers.
+ *
+ * Results are printed on terminal 0 in clock ticks per call.
+ */
+
+#include <primitive_types.h>
+#include <assertions.h>
+#include <core.h>
+#include <kinfo.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_ROUNDS    1000
+
+static void bench(void) {
+    const void *pid = NULL;
+    const void *parentPid = NULL;
+    ticks_t userTime = 0, kernelTime = 0, wallclockTime = 0;
+    ticks64_t userTime64 = 0, kernelTime64 = 0, wallclockTime64 = 0;
+    ticks_t start;
+
+    SYSCALL(GETPID, (memaddr) &pid, (memaddr) &parentPid, 0);
+    assert(kinfo_getPid() == pid);
+    assert(kinfo_getParentPid() == parentPid);
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(GETPID, (memaddr) &pid, 0, 0);
+    }
+    bench_report("GETPID syscall: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        pid = kinfo_getPid();
+    }
+    bench_report("GETPID info page: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(GETCPUTIME, (memaddr) &userTime, (memaddr) &kernelTime, (memaddr) &wallclockTime);
+    }
+    bench_report("GETCPUTIME syscall: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        kinfo_getCpuTime(&userTime, &kernelTime, &wallclockTime);
+    }
+    bench_report("GETCPUTIME info page: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(GETCPUTIME64, (memaddr) &userTime64, (memaddr) &kernelTime64, (memaddr) &wallclockTime64);
+    }
+    bench_report("GETCPUTIME64 syscall: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        kinfo_getCpuTime64(&userTime64, &kernelTime64, &wallclockTime64);
+    }
+    bench_report("GETCPUTIME64 info page: ", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/call\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,60 @@
+/**
+ * Measures memdup and memclr on a 4 KiB buffer: aligned copy, copy between
+ * buffers with different alignment (byte-wise path), aligned clear and a
+ * copy of a process state (the size moved on every context switch).
+ *
+ * Results are printed on terminal 0 in clock ticks per KiB (per state copy
+ * for the last one).
+ */
+
+#include <primitive_types.h>
+#include <memory.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_BUFFER_SIZE   4096U
+#define BENCH_ROUNDS        64U
+
+static u32 source[BENCH_BUFFER_SIZE / sizeof(u32) + 1];
+static u32 destination[BENCH_BUFFER_SIZE / sizeof(u32) + 1];
+static cpustate_t states[2];
+
+static ticks_t perKiB(const ticks_t elapsed) {
+    return elapsed / (BENCH_ROUNDS * (BENCH_BUFFER_SIZE / 1024U));
+}
+
+static void bench(void) {
+    u8 *const misalignedSource = (u8 *) source + 1;
+    ticks_t start;
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        memdup(destination, source, BENCH_BUFFER_SIZE);
+    }
+    bench_report("memdup aligned=", perKiB(machine_getTODLow() - start), " ticks/KiB\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        memdup(destination, misalignedSource, BENCH_BUFFER_SIZE);
+    }
+    bench_report("memdup misaligned=", perKiB(machine_getTODLow() - start), " ticks/KiB\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        memclr(destination, BENCH_BUFFER_SIZE);
+    }
+    bench_report("memclr aligned=", perKiB(machine_getTODLow() - start), " ticks/KiB\n");
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        memdup(&states[i & 1U], &states[~i & 1U], sizeof(cpustate_t));
+    }
+    bench_report("memdup state=", (machine_getTODLow() - start) / BENCH_ROUNDS, " ticks/copy\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,94 @@
+/**
+ * Compares the cost of a dispatch on the sorted ready list (insertProcQ plus
+ * the aging walk) with the one on the bucketed ready queue (insertReadyQ plus
+ * ageReadyQ), with 20, 200 and 2000 runnable processes.
+ *
+ * Results are printed on terminal 0 in clock ticks per dispatch.
+ *
+ * Note: the process pool takes a few hundreds of KiB, so the emulator must be
+ *       configured with at least 1 MiB of RAM.
+ */
+
+#include <primitive_types.h>
+#include <core.h>
+#include <pcb.h>
+#include <readyq.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_MAX_PROC  2000
+#define BENCH_ROUNDS    1000
+
+static struct pcb_t pool[BENCH_MAX_PROC];
+static struct list_head sortedQueue;
+static struct readyq_t bucketQueue;
+static u32 seed = 1;
+
+static int randomPriority(void) {
+    seed = seed * 1103515245U + 12345U;
+    return (int) ((seed >> 16) % 16);
+}
+
+static ticks_t sortedDispatch(const usize n) {
+    mkEmptyProcQ(&sortedQueue);
+    seed = 1;
+    for (usize i = 0; i < n; ++i) {
+        pool[i].priority = pool[i].original_priority = randomPriority();
+        insertProcQ(&sortedQueue, &pool[i]);
+    }
+
+    const ticks_t start = machine_getTODLow();
+
+    for (usize i = 0; i < BENCH_ROUNDS; ++i) {
+        struct pcb_t *iter = NULL;
+        struct pcb_t *const proc = removeProcQ(&sortedQueue);
+
+        list_for_each_entry(iter, &sortedQueue, p_next) {
+            iter->priority += 1;
+        }
+
+        proc->priority = proc->original_priority;
+        insertProcQ(&sortedQueue, proc);
+    }
+
+    return (machine_getTODLow() - start) / BENCH_ROUNDS;
+}
+
+static ticks_t bucketDispatch(const usize n) {
+    mkEmptyReadyQ(&bucketQueue);
+    seed = 1;
+    for (usize i = 0; i < n; ++i) {
+        pool[i].priority = pool[i].original_priority = randomPriority();
+        insertReadyQ(&bucketQueue, &pool[i]);
+    }
+
+    const ticks_t start = machine_getTODLow();
+
+    for (usize i = 0; i < BENCH_ROUNDS; ++i) {
+        struct pcb_t *const proc = removeReadyQ(&bucketQueue);
+        ageReadyQ(&bucketQueue);
+        proc->priority = proc->original_priority;
+        insertReadyQ(&bucketQueue, proc);
+    }
+
+    return (machine_getTODLow() - start) / BENCH_ROUNDS;
+}
+
+static void bench(void) {
+    static const usize sizes[] = { 20, 200, 2000 };
+
+    for (usize i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        const ticks_t sorted = sortedDispatch(sizes[i]);
+        const ticks_t bucket = bucketDispatch(sizes[i]);
+
+        bench_report("runnable=", sizes[i], " ");
+        bench_report("sorted=", sorted, " ");
+        bench_report("bucket=", bucket, " ticks/dispatch\n");
+    }
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,70 @@
+/**
+ * BENCH_SLEEPERS processes sleep BENCH_ROUNDS times each, every one with its own
+ * delay, while a CPU-bound process counts how many iterations it manages to
+ * perform in the meantime: since sleepers wait in the sleep queue rather than
+ * polling the TOD, the CPU-bound process gets the processor all along.
+ *
+ * Once all of them are done the worst lateness of a wakeup (in clock ticks)
+ * and the iterations are printed on terminal 0.
+ */
+
+#include <primitive_types.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_SLEEPERS  16
+#define BENCH_ROUNDS    8
+#define BENCH_DELAY     1000    // microseconds, multiplied by the index of the sleeper
+
+static int doneSem = 0;
+static unsigned nextSleeper = 0;
+static ticks_t worstLateness = 0;
+static volatile bool sleepersDone = false;
+
+static void sleeper(void) {
+    const u32 delay = BENCH_DELAY * ++nextSleeper;
+    const ticks_t ticks = delay * machine_getClockResolution();
+
+    for (unsigned i = 0; i < BENCH_ROUNDS; ++i) {
+        const ticks_t start = machine_getTODLow();
+        SYSCALL(SLEEP, delay, 0, 0);
+        const ticks_t lateness = machine_getTODLow() - start - ticks;
+
+        worstLateness = (lateness > worstLateness) ? lateness : worstLateness;
+    }
+
+    SYSCALL(VERHOGEN, (memaddr) &doneSem, 0, 0);
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void cpuBound(void) {
+    u32 iterations = 0;
+
+    while (!sleepersDone) {
+        iterations += 1;
+    }
+
+    bench_report("iterations=", iterations, "\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void reporter(void) {
+    for (unsigned i = 0; i < BENCH_SLEEPERS; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &doneSem, 0, 0);
+    }
+
+    sleepersDone = true;
+
+    bench_report("sleepers=", BENCH_SLEEPERS, " ");
+    bench_report("worst lateness=", worstLateness, " ticks\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=reporter, .priority=3, .interruptsEnabled=true, .copies=1 },
+    { .entry=sleeper, .priority=2, .interruptsEnabled=true, .copies=BENCH_SLEEPERS },
+    { .entry=cpuBound, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
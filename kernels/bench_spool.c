@@ -0,0 +1,67 @@
+/**
+ * Prints the same batch of pages first with printer_puts on printer 0 and then
+ * through the printer spooler, which spreads the pages over every installed
+ * printer and signals a semaphore as each of them has been printed.
+ *
+ * Results are printed on terminal 0 in clock ticks per batch.
+ *
+ * Note: the emulator must be configured with all the 8 printers installed for
+ *       the spooler to print the pages in parallel.
+ */
+
+#include <primitive_types.h>
+#include <printer.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_PAGES     16
+
+static const char page[] =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n"
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam,\n"
+    "quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo.\n";
+
+static int printed = 0;
+
+static ticks_t direct(void) {
+    const ticks_t start = machine_getTODLow();
+
+    for (usize i = 0; i < BENCH_PAGES; ++i) {
+        printer_puts(0, page);
+    }
+
+    return machine_getTODLow() - start;
+}
+
+static ticks_t spooled(void) {
+    const ticks_t start = machine_getTODLow();
+
+    for (usize i = 0; i < BENCH_PAGES; ++i) {
+        if (0 > printer_spool(page, sizeof(page) - 1, &printed)) {
+            bench_puts("spool rejected\n");
+            SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+        }
+    }
+
+    for (usize i = 0; i < BENCH_PAGES; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &printed, 0, 0);
+    }
+
+    return machine_getTODLow() - start;
+}
+
+static void bench(void) {
+    const ticks_t sequential = direct();
+    const ticks_t parallel = spooled();
+
+    bench_report("pages=", BENCH_PAGES, " ");
+    bench_report("puts=", sequential, " ");
+    bench_report("spool=", parallel, " ticks\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,72 @@
+/**
+ * Measures the cost of the process tree operations on a 10k-node tree:
+ * building a random tree (insertChild), walking it in post-order,
+ * moving random nodes under the root (outChild plus insertChild) and
+ * emptying the root (removeChild).
+ *
+ * Results are printed on terminal 0 in clock ticks per node.
+ *
+ * Note: the node pool takes a couple of MiB, so the emulator must be
+ *       configured with at least 4 MiB of RAM.
+ */
+
+#include <primitive_types.h>
+#include <assertions.h>
+#include <helpers.h>
+#include <memory.h>
+#include <core.h>
+#include <pcb.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define TREE_SIZE   10000
+
+static struct pcb_t pool[TREE_SIZE];
+static u32 seed = 1;
+
+static void bench(void) {
+    struct pcb_t *const root = &pool[0];
+    ticks_t start;
+
+    memclr(pool, sizeof(pool));
+    for (usize i = 0; i < TREE_SIZE; ++i) {
+        INIT_LIST_HEAD(&pool[i].p_next);
+        INIT_LIST_HEAD(&pool[i].p_child);
+        INIT_LIST_HEAD(&pool[i].p_sib);
+    }
+
+    start = machine_getTODLow();
+    for (usize i = 1; i < TREE_SIZE; ++i) {
+        insertChild(&pool[u32_random(&seed, (u32) i)], &pool[i]);
+    }
+    bench_report("insertChild=", (machine_getTODLow() - start) / TREE_SIZE, " ticks/node\n");
+
+    usize visited = 0;
+    start = machine_getTODLow();
+    for (struct pcb_t *node = firstPostOrder(root); NULL != node; node = nextPostOrder(root, node)) {
+        visited += 1;
+    }
+    bench_report("post-order walk=", (machine_getTODLow() - start) / TREE_SIZE, " ticks/node\n");
+    assert(TREE_SIZE == visited);
+
+    // each node is moved under the root along with its sub-tree
+    start = machine_getTODLow();
+    for (usize i = 1; i < TREE_SIZE; ++i) {
+        struct pcb_t *const node = &pool[u32_random(&seed, TREE_SIZE - 1) + 1];
+        outChild(node);
+        insertChild(root, node);
+    }
+    bench_report("outChild+insertChild=", (machine_getTODLow() - start) / TREE_SIZE, " ticks/node\n");
+
+    start = machine_getTODLow();
+    while (NULL != removeChild(root)) {
+        continue;
+    }
+    bench_report("removeChild=", (machine_getTODLow() - start) / TREE_SIZE, " ticks/node\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
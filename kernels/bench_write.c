@@ -0,0 +1,61 @@
+/**
+ * Measures the throughput of terminal 0 printing the same text first one
+ * character at a time through WAITIO, then through the kernel-buffered WRITE
+ * (term_puts). A final character sent through WAITIO waits for the output
+ * queue to be drained, so the second measure covers the whole transmission.
+ *
+ * Results are printed on terminal 0 in characters per second.
+ */
+
+#include <primitive_types.h>
+#include <term.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_LINES     16U
+#define CMD_TRANSMIT    2U
+#define BYTE_OFFSET     8U
+
+static const char line[] =
+    "The quick brown fox jumps over the lazy dog, then it jumps back again.\n";
+
+static void waitPutchar(const char c) {
+    SYSCALL(WAITIO, (((unsigned) c) << BYTE_OFFSET) | CMD_TRANSMIT, DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0), 0);
+}
+
+static u32 charsPerSecond(const u32 chars, const ticks_t elapsed) {
+    // the clock resolution is given in ticks per microsecond (no 64-bit division without libgcc)
+    const ticks_t millis = elapsed / machine_getClockResolution() / 1000U;
+    return (0 == millis) ? 0 : (chars * 1000U) / millis;
+}
+
+static void bench(void) {
+    const u32 chars = BENCH_LINES * (sizeof(line) - 1) + 1;
+    ticks_t start;
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_LINES; ++i) {
+        for (const char *c = line; *c; ++c) {
+            waitPutchar(*c);
+        }
+    }
+    waitPutchar('\n');
+    const u32 waitRate = charsPerSecond(chars, machine_getTODLow() - start);
+
+    start = machine_getTODLow();
+    for (u32 i = 0; i < BENCH_LINES; ++i) {
+        term_puts(0, line);
+    }
+    waitPutchar('\n');
+    const u32 writeRate = charsPerSecond(chars, machine_getTODLow() - start);
+
+    bench_report("WAITIO: ", waitRate, " chars/s\n");
+    bench_report("WRITE: ", writeRate, " chars/s\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=bench, .priority=1, .copies=1 }
+)
@@ -0,0 +1,52 @@
+/**
+ * An I/O-bound process prints a text on terminal 0 while a CPU-bound process
+ * counts how many iterations it manages to perform in the meantime.
+ * Since WAITIO blocks the caller, the CPU-bound process keeps running while
+ * each character is being transmitted.
+ */
+
+#include <primitive_types.h>
+#include <term.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+static const char text[] =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n"
+    "tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam,\n"
+    "quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo\n"
+    "consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse.\n";
+
+static volatile bool ioDone = false;
+static int reportSem = 0;
+
+static void ioBound(void) {
+    const ticks_t start = machine_getTODLow();
+    term_puts(0, text);
+    const ticks_t elapsed = machine_getTODLow() - start;
+
+    ioDone = true;
+    SYSCALL(PASSEREN, (memaddr) &reportSem, 0, 0);
+
+    bench_report("I/O-bound process: ", elapsed, " ticks\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void cpuBound(void) {
+    u32 iterations = 0;
+
+    while (!ioDone) {
+        iterations += 1;
+    }
+
+    bench_report("CPU-bound process: ", iterations, " iterations while printing\n");
+
+    SYSCALL(VERHOGEN, (memaddr) &reportSem, 0, 0);
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=ioBound, .priority=2, .interruptsEnabled=true, .copies=1 },
+    { .entry=cpuBound, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
@@ -0,0 +1,58 @@
+/**
+ * Measures the round-trip time of a P/V ping-pong between a low priority
+ * process, which signals a semaphore and then busy-waits for the answer, and
+ * a high priority process blocked on that semaphore.
+ *
+ * Without preemption on wake-up the high priority process can run only once
+ * the time slice of the other one expires, so the round trip is bounded by
+ * TIME_SLICE; with preemption it is the cost of a couple of syscalls.
+ *
+ * Results (average and maximum) are printed on terminal 0 in clock ticks.
+ */
+
+#include <primitive_types.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define BENCH_ROUNDS    100
+
+static int pingSem = 0;
+static volatile u32 pongs = 0;
+
+static void ponger(void) {
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        SYSCALL(PASSEREN, (memaddr) &pingSem, 0, 0);
+        pongs += 1;
+    }
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+static void pinger(void) {
+    ticks_t total = 0;
+    ticks_t worst = 0;
+
+    for (u32 i = 0; i < BENCH_ROUNDS; ++i) {
+        const ticks_t start = machine_getTODLow();
+        SYSCALL(VERHOGEN, (memaddr) &pingSem, 0, 0);
+
+        while (pongs == i) {
+            continue;
+        }
+
+        const ticks_t elapsed = machine_getTODLow() - start;
+        total += elapsed;
+        worst = (elapsed > worst) ? elapsed : worst;
+    }
+
+    bench_report("ping-pong round trip: avg=", total / BENCH_ROUNDS, " ");
+    bench_report("max=", worst, " ticks\n");
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=ponger, .priority=10, .interruptsEnabled=true, .copies=1 },
+    { .entry=pinger, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
@@ -1,4 +1,5 @@
 #include <pcb.h>
+#include <asl.h>
 #include <core.h>
 #include <scheduler.h>
 #include <assertions.h>
@@ -11,23 +12,26 @@ void f(void) {
     insertChild(root, child1);
     insertChild(root, child2);
 
-    assert(list_next(&root->p_child) == &child1->p_child);
-    assert(list_next(&child1->p_child) == &root->p_child);
-    assert(child1->p_parent == root);
-
+    assert(list_next(&root->p_child) == &child1->p_sib);
     assert(list_next(&child1->p_sib) == &child2->p_sib);
-    assert(list_next(&child2->p_sib) == &child1->p_sib);
-    assert(list_next(&child2->p_child) == NULL);
+    assert(list_next(&child2->p_sib) == &root->p_child);
+    assert(2 == root->p_childCount);
+    assert(child1->p_parent == root);
     assert(child2->p_parent == root);
+    assert(firstChild(root) == child1);
+    assert(nextSibling(child1) == child2);
+    assert(nextSibling(child2) == NULL);
+    assert(prevSibling(child2) == child1);
+    assert(prevSibling(child1) == NULL);
 
     assert(outChild(child2) == child2);
     assert(NULL == child2->p_parent);
     assert(list_next(&child2->p_sib) == NULL);
     assert(list_next(&child2->p_child) == NULL);
 
-    assert(list_next(&root->p_child) == &child1->p_child);
-    assert(list_next(&child1->p_child) == &root->p_child);
-    assert(list_next(&child1->p_sib) == NULL);
+    assert(list_next(&root->p_child) == &child1->p_sib);
+    assert(list_next(&child1->p_sib) == &root->p_child);
+    assert(1 == root->p_childCount);
     assert(child1->p_parent == root);
 
     assert(outChild(child2) == NULL);
@@ -35,9 +39,8 @@ void f(void) {
     assert(list_next(&child2->p_sib) == NULL);
     assert(list_next(&child2->p_child) == NULL);
 
-    assert(list_next(&root->p_child) == &child1->p_child);
-    assert(list_next(&child1->p_child) == &root->p_child);
-    assert(list_next(&child1->p_sib) == NULL);
+    assert(list_next(&root->p_child) == &child1->p_sib);
+    assert(list_next(&child1->p_sib) == &root->p_child);
     assert(child1->p_parent == root);
 
     assert(outChild(child1) == child1);
@@ -45,6 +48,7 @@ void f(void) {
     assert(list_next(&child1->p_sib) == NULL);
     assert(list_next(&child1->p_child) == NULL);
     assert(list_next(&root->p_child) == NULL);
+    assert(0 == root->p_childCount);
 
     SYSCALL(TERMINATEPROCESS, 0, 0, 0);
 }
@@ -57,8 +61,8 @@ void g(void) {
     insertChild(root, node);
     insertChild(node, leaf);
 
-    assert(list_next(&root->p_child) == &node->p_child);
-    assert(list_next(&node->p_child) == &leaf->p_child);
+    assert(list_next(&root->p_child) == &node->p_sib);
+    assert(list_next(&node->p_child) == &leaf->p_sib);
     assert(root == node->p_parent);
     assert(node == leaf->p_parent);
 
@@ -66,13 +70,14 @@ void g(void) {
 
     assert(removeChild(node) == leaf);
     assert(NULL == leaf->p_parent);
-    assert(list_next(&leaf->p_child) == NULL);
-    assert(list_next(&root->p_child) == &node->p_child);
-    assert(list_next(&node->p_child) == &root->p_child);
+    assert(list_next(&leaf->p_sib) == NULL);
+    assert(list_next(&node->p_child) == NULL);
+    assert(list_next(&root->p_child) == &node->p_sib);
+    assert(list_next(&node->p_sib) == &root->p_child);
 
     assert(removeChild(root) == node);
     assert(NULL == node->p_parent);
-    assert(list_next(&node->p_child) == NULL);
+    assert(list_next(&node->p_sib) == NULL);
     assert(list_next(&root->p_child) == NULL);
 
     SYSCALL(TERMINATEPROCESS, 0, 0, 0);
@@ -0,0 +1,34 @@
+/**
+ * Checks that the only process of the system wakes up from SLEEP: while it
+ * sleeps the processor idles, so the interval timer must be able to end the
+ * wait. The kernel halts once the checks are done, hanging is a failure.
+ *
+ * Each delay is checked against the TOD: a process never wakes up early.
+ */
+
+#include <primitive_types.h>
+#include <assertions.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+
+static void run(void) {
+    static const u32 delays[] = { 1, 10, 1000, 100000 };    // microseconds
+
+    for (usize i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i) {
+        const ticks_t start = machine_getTODLow();
+
+        assert(0 == SYSCALL(SLEEP, delays[i], 0, 0));
+        assert(machine_getTODLow() - start >= delays[i] * machine_getClockResolution());
+    }
+
+    // zero is no delay at all and a delay beyond the wheel is refused.
+    assert(0 == SYSCALL(SLEEP, 0, 0, 0));
+    assert(-1 == (int) SYSCALL(SLEEP, 0xFFFFFFFFU, 0, 0));
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=run, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
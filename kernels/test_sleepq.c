@@ -0,0 +1,220 @@
+/**
+ * Checks the timer wheel of the sleep queue: insertion, cancellation and
+ * expiry on every level, cascading across the level boundaries, the wheel
+ * jumping over several events at once, the longest delay, the wraparound of
+ * TODLow, a wheel left alone for more than 2^31 ticks and SLEEP_POOL_SIZE
+ * sleepers pending at once.
+ *
+ * Times are made up rather than read from the TOD, so the checks do not
+ * depend on the speed of the emulator.
+ *
+ * Note: the process pool takes a few hundreds of KiB, so the emulator must be
+ *       configured with at least 1 MiB of RAM.
+ */
+
+#include <primitive_types.h>
+#include <assertions.h>
+#include <helpers.h>
+#include <core.h>
+#include <pcb.h>
+#include <sleepq.h>
+#include <scheduler.h>
+#include <bench.h>
+
+#define SLEEP_POOL_SIZE     3000
+#define LEVEL_SPAN(l)       (1U << (5U * (l)))
+
+static struct pcb_t pool[SLEEP_POOL_SIZE];
+static struct sleepq_t q;
+static u32 seed = 1;
+
+static void resetPool(void) {
+    for (usize i = 0; i < SLEEP_POOL_SIZE; ++i) {
+        INIT_LIST_HEAD(&pool[i].p_next);
+        pool[i].p_queue = PcbQueue_None;
+    }
+}
+
+static bool isDue(const struct pcb_t *const p, const ticks_t now) {
+    return 0 >= (i32) (p->wakeup_time - now);
+}
+
+/**
+ * Removes every expired process checking that it was due, returns how many they were.
+ */
+static usize expire(const ticks_t now) {
+    usize expired = 0;
+
+    for (struct pcb_t *p = removeSleepQ(&q, now); NULL != p; p = removeSleepQ(&q, now)) {
+        assert(isDue(p, now));
+        assert(PcbQueue_None == p->p_queue);
+        expired += 1;
+    }
+
+    // nothing that is due may be left behind
+    for (usize i = 0; i < SLEEP_POOL_SIZE; ++i) {
+        assert(PcbQueue_Sleeping != pool[i].p_queue || !isDue(&pool[i], now));
+    }
+
+    return expired;
+}
+
+/**
+ * Sleeps a single process for delay ticks from start, checking that it expires exactly on time.
+ */
+static void checkExpiry(const ticks_t start, const u32 delay) {
+    struct pcb_t *const p = &pool[0];
+
+    mkEmptySleepQ(&q, start);
+    insertSleepQ(&q, p, start + delay);
+    assert(!emptySleepQ(&q));
+    assert(0 < (i32) (nextEventSleepQ(&q) - start));
+    assert(!isDue(p, nextEventSleepQ(&q)) || nextEventSleepQ(&q) == p->wakeup_time);
+
+    assert(0 == expire(start + delay - 1));
+    assert(1 == expire(start + delay));
+    assert(emptySleepQ(&q));
+}
+
+static void checkLevels(void) {
+    // the first and the last delay of each level, from a tick that sits on and
+    // right before the boundary of every level, and across the wraparound.
+    static const ticks_t starts[] = { 0U, 1U, LEVEL_SPAN(1) - 1U, LEVEL_SPAN(2) - 1U, LEVEL_SPAN(5) - 1U, 0xFFFFFFFFU, 0xFFFFFF00U, 0xC0000123U };
+
+    for (usize s = 0; s < sizeof(starts) / sizeof(starts[0]); ++s) {
+        for (u32 level = 0; level < SLEEPQ_LEVELS; ++level) {
+            checkExpiry(starts[s], (0 == level) ? 1U : LEVEL_SPAN(level));
+            checkExpiry(starts[s], LEVEL_SPAN(level + 1) - 1U);
+            checkExpiry(starts[s], LEVEL_SPAN(level + 1) / 2U + 17U);
+        }
+
+        checkExpiry(starts[s], SLEEPQ_MAX_DELAY);
+    }
+}
+
+static void checkCancel(void) {
+    const ticks_t start = 0xFFFFF000U;
+
+    // three processes on the same slot of every level: the middle, the first and then the last one are cancelled.
+    mkEmptySleepQ(&q, start);
+    for (u32 level = 0; level < SLEEPQ_LEVELS; ++level) {
+        const u32 delay = (0 == level) ? 5U : 5U * LEVEL_SPAN(level);
+
+        for (usize i = 0; i < 3; ++i) {
+            insertSleepQ(&q, &pool[3 * level + i], start + delay);
+        }
+    }
+
+    for (u32 level = 0; level < SLEEPQ_LEVELS; ++level) {
+        assert(outSleepQ(&q, &pool[3 * level + 1]) == &pool[3 * level + 1]);
+        assert(outSleepQ(&q, &pool[3 * level]) == &pool[3 * level]);
+        assert(!emptySleepQ(&q));
+        assert(outSleepQ(&q, &pool[3 * level + 2]) == &pool[3 * level + 2]);
+        assert(PcbQueue_None == pool[3 * level + 2].p_queue);
+    }
+
+    assert(emptySleepQ(&q));
+
+    // a cancelled process must not be woken up, nor hide the next one
+    insertSleepQ(&q, &pool[0], start + 3U * LEVEL_SPAN(2));
+    insertSleepQ(&q, &pool[1], start + 7U * LEVEL_SPAN(3));
+    outSleepQ(&q, &pool[0]);
+    assert(0 >= (i32) (nextEventSleepQ(&q) - pool[1].wakeup_time));
+    assert(0 == expire(pool[0].wakeup_time));
+    assert(0 == expire(pool[1].wakeup_time - 1U));
+    assert(1 == expire(pool[1].wakeup_time));
+    assert(emptySleepQ(&q));
+}
+
+static void checkResync(void) {
+    const ticks_t start = 0x00000100U;
+    const ticks_t later = start + 0x90000000U;
+
+    // the wheel is left alone for longer than 2^31 ticks while empty
+    mkEmptySleepQ(&q, start);
+    insertSleepQ(&q, &pool[0], start + 5U);
+    assert(1 == expire(start + 5U));
+    assert(0 == expire(later));
+    insertSleepQ(&q, &pool[0], later + SLEEPQ_MAX_DELAY);
+    assert(0 == expire(later + SLEEPQ_MAX_DELAY - 1U));
+
+    // and it follows now while a far sleeper is pending, so the longest delay is available from there
+    insertSleepQ(&q, &pool[1], later + 2U * SLEEPQ_MAX_DELAY - 1U);
+    assert(1 == expire(later + SLEEPQ_MAX_DELAY));
+    assert(0 == expire(later + 2U * SLEEPQ_MAX_DELAY - 2U));
+    assert(1 == expire(later + 2U * SLEEPQ_MAX_DELAY - 1U));
+    assert(emptySleepQ(&q));
+}
+
+static void checkJump(void) {
+    const ticks_t start = 0xFFFF0000U;
+    usize n = 0;
+
+    // one process for every level and every slot distance, all expired by a single call
+    mkEmptySleepQ(&q, start);
+    for (u32 level = 0; level < SLEEPQ_LEVELS; ++level) {
+        for (u32 slots = 1; slots < 32 && n < SLEEP_POOL_SIZE; slots += 3) {
+            insertSleepQ(&q, &pool[n++], start + slots * LEVEL_SPAN(level));
+        }
+    }
+
+    assert(0 == expire(start));
+    assert(n == expire(start + SLEEPQ_MAX_DELAY));
+    assert(emptySleepQ(&q));
+}
+
+/**
+ * Returns a delay on a random level of the wheel.
+ */
+static u32 randomDelay(void) {
+    const u32 level = u32_random(&seed, SLEEPQ_LEVELS);
+    const u32 bits = (u32_random(&seed, 1U << 15) << 15) | u32_random(&seed, 1U << 15);
+    return LEVEL_SPAN(level) + bits % (31U * LEVEL_SPAN(level));
+}
+
+static void checkMany(void) {
+    ticks_t now = 0xF0000000U;
+    usize pending = 0;
+
+    mkEmptySleepQ(&q, now);
+    for (usize i = 0; i < SLEEP_POOL_SIZE; ++i) {
+        insertSleepQ(&q, &pool[i], now + randomDelay());
+        pending += 1;
+    }
+
+    for (usize i = 0; i < SLEEP_POOL_SIZE; i += 7) {
+        outSleepQ(&q, &pool[i]);
+        pending -= 1;
+    }
+
+    // the wheel is advanced event by event or by random leaps, while new sleepers come in
+    while (0 < pending) {
+        const ticks_t next = nextEventSleepQ(&q);
+        now = (0 == u32_random(&seed, 4)) ? next + u32_random(&seed, 1U << 15) : next;
+        pending -= expire(now);
+
+        struct pcb_t *const p = &pool[u32_random(&seed, SLEEP_POOL_SIZE)];
+        if (0 == u32_random(&seed, 8) && PcbQueue_None == p->p_queue) {
+            insertSleepQ(&q, p, now + randomDelay());
+            pending += 1;
+        }
+    }
+
+    assert(emptySleepQ(&q));
+}
+
+static void run(void) {
+    resetPool();
+
+    checkLevels();
+    checkCancel();
+    checkResync();
+    checkJump();
+    checkMany();
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=run, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
@@ -0,0 +1,82 @@
+/**
+ * Checks the post-order traversal of the process tree and outChildBlocked on
+ * a TREE_SIZE-deep chain and on a TREE_SIZE-wide fan-out.
+ *
+ * Note: each pcb reserves a stack frame, the emulator needs at least 2 MiB of RAM.
+ */
+
+#include <pcb.h>
+#include <asl.h>
+#include <core.h>
+#include <scheduler.h>
+#include <bench.h>
+#include <assertions.h>
+
+#define TREE_SIZE 1000
+
+static struct pcb_t *nodes[TREE_SIZE];
+static int sem = 0;
+
+/**
+ * Checks the post-order traversal and outChildBlocked on the tree made of
+ * nodes, where parent(i) gives the index of the parent of the i-th node.
+ * Both must cope with TREE_SIZE nodes using a bounded amount of stack.
+ */
+static void checkTree(usize (*const parent)(usize i)) {
+    for (usize i = 0; i < TREE_SIZE; ++i) {
+        nodes[i] = allocPcb();
+        assert(NULL != nodes[i]);
+        nodes[i]->priority = -1;
+    }
+
+    for (usize i = 1; i < TREE_SIZE; ++i) {
+        insertChild(nodes[parent(i)], nodes[i]);
+    }
+
+    // priority is used as the visit order: children come before their parent.
+    int order = 0;
+    for (struct pcb_t *node = firstPostOrder(nodes[0]); NULL != node; node = nextPostOrder(nodes[0], node)) {
+        assert(-1 == node->priority);
+        node->priority = order++;
+    }
+
+    assert(TREE_SIZE == order);
+    for (usize i = 1; i < TREE_SIZE; ++i) {
+        assert(nodes[i]->priority < nodes[parent(i)]->priority);
+    }
+
+    for (usize i = 0; i < TREE_SIZE; ++i) {
+        assert(0 == insertBlocked(&sem, nodes[i]));
+    }
+
+    outChildBlocked(nodes[0]);
+    assert(NULL == headBlocked(&sem));
+
+    for (usize i = TREE_SIZE - 1; i > 0; --i) {
+        assert(outChild(nodes[i]) == nodes[i]);
+    }
+
+    for (usize i = 0; i < TREE_SIZE; ++i) {
+        freePcb(nodes[i]);
+    }
+}
+
+static usize chainParent(const usize i) {
+    return i - 1;
+}
+
+static usize fanOutParent(const usize i) {
+    (void) i;
+    return 0;
+}
+
+static void run(void) {
+    checkTree(chainParent);
+    checkTree(fanOutParent);
+
+    SYSCALL(TERMINATEPROCESS, 0, 0, 0);
+}
+
+BENCH_MAIN(
+    { .entry=run, .priority=1, .interruptsEnabled=true, .copies=1 }
+)
@@ -2,21 +2,83 @@
 #include <assertions.h>
 #include <const_bikaya.h>
 #include <listx.h>
+#include <slab.h>
 #include <pcb.h>
 #include <asl.h>
 
-static struct semd_t semd_table[MAX_SEM_NO];
+// smallest power of 2 greater or equal to n (n > 0)
+#define POW2_CEIL(n)    (POW2_SMEAR((n) - 1U) + 1U)
+#define POW2_SMEAR(n)   ((n) | ((n) >> 1) | ((n) >> 2) | ((n) >> 4) | ((n) >> 8) | ((n) >> 16))
+
+// number of buckets of the hash table: load factor is at most 1 up to MAX_SEM_NO active semaphores
+#define SEMD_BUCKETS_NO POW2_CEIL((u32) MAX_SEM_NO)
+#define SEMD_BUCKET_MASK (SEMD_BUCKETS_NO - 1U)
+
+// number of semds in each slab
+#define SEMD_PER_SLAB   ((SLAB_SIZE - sizeof(struct SemdSlab *)) / sizeof(struct semd_t))
+
+static_assert(0 < MAX_SEM_NO, "MAX_SEM_NO must be positive");
+
+// Slab of semds carved on demand (see slab.h)
+struct SemdSlab {
+    struct SemdSlab *next;
+    struct semd_t semds[SEMD_PER_SLAB];
+};
+
+static_assert(sizeof(struct SemdSlab) <= SLAB_SIZE, "a slab must fit SLAB_SIZE bytes");
+
+static struct SemdSlab *semd_slabs = NULL;
 static struct list_head semd_free;
-static struct list_head semd_busy;
+static struct list_head semd_buckets[SEMD_BUCKETS_NO];
+
+/**
+ * Returns the bucket of the active semaphores whose keys hash as key.
+ */
+static struct list_head *bucketOf(const int *const key) {
+    // keys are word aligned: low bits are dropped and the others are mixed
+    // up with a multiplicative hash (Knuth) so that adjacent keys spread.
+    u32 h = ((u32) (memaddr) key >> 2) * 2654435761U;
+    h ^= h >> 16;
+    return &semd_buckets[h & SEMD_BUCKET_MASK];
+}
+
+static void freeSlab(struct SemdSlab *const slab) {
+    debug_assert(NULL != slab);
+
+    const struct semd_t *const end = &slab->semds[SEMD_PER_SLAB];
+    for (struct semd_t *cur = &slab->semds[0]; end > cur; ++cur) {
+        mkEmptyProcQ(&cur->s_procQ);
+        list_add_tail(&cur->s_next, &semd_free);
+    }
+}
+
+/**
+ * Carves a new slab of semds adding them to the free list.
+ * Returns false if there is no free RAM left.
+ */
+static bool growSemds(void) {
+    struct SemdSlab *const slab = slab_carve(0);
+
+    if (NULL == slab) {
+        return false;
+    }
+
+    slab->next = semd_slabs;
+    semd_slabs = slab;
+    freeSlab(slab);
+    return true;
+}
 
 void initASL(void) {
     INIT_LIST_HEAD(&semd_free);
-    INIT_LIST_HEAD(&semd_busy);
 
-    const struct semd_t *const end = &semd_table[MAX_SEM_NO];
-    for (struct semd_t *cur = &semd_table[0]; end > cur; ++cur) {
-        mkEmptyProcQ(&cur->s_procQ);
-        list_add(&cur->s_next, &semd_free);
+    for (u32 i = 0; i < SEMD_BUCKETS_NO; ++i) {
+        INIT_LIST_HEAD(&semd_buckets[i]);
+    }
+
+    // slabs carved so far are reused, new ones are carved on demand.
+    for (struct SemdSlab *slab = semd_slabs; NULL != slab; slab = slab->next) {
+        freeSlab(slab);
     }
 }
 
@@ -24,7 +86,7 @@ struct semd_t *getSemd(int *const key) {
     debug_assert(NULL != key);
     struct semd_t *iter = NULL;
 
-    list_for_each_entry(iter, &semd_busy, s_next) {
+    list_for_each_entry(iter, bucketOf(key), s_next) {
         if (key == iter->s_key) {
             return iter;
         }
@@ -41,8 +103,8 @@ int insertBlocked(int *const key, struct pcb_t *const p) {
     if (NULL == s) {
         // no sem with the given key -> add a new sem removing one from semd_free.
 
-        if (list_empty(&semd_free)) {
-            // there are no sems left -> nothing to do.
+        if (list_empty(&semd_free) && !growSemds()) {
+            // there are no sems left nor free RAM to carve new ones -> nothing to do.
             return 1;
         } else {
             // we have at least one available sem.
@@ -54,17 +116,19 @@ int insertBlocked(int *const key, struct pcb_t *const p) {
             list_del(s_node);
             INIT_LIST_HEAD(s_node);
 
-            // adding the sem from semd_busy.
-            list_add_tail(s_node, &semd_busy);
+            // adding the sem to the bucket of its key.
+            list_add_tail(s_node, bucketOf(key));
 
             s = container_of(s_node, struct semd_t, s_next);
             s->s_key = key;
         }
     }
 
-    // ensure that the proc was not already associated to a sem.
+    // ensure that the proc was not already associated to a sem nor in another queue.
     debug_assert(NULL == p->p_semkey);
+    debug_assert(PcbQueue_None == p->p_queue || PcbQueue_Running == p->p_queue);
     p->p_semkey = key;
+    p->p_queue = PcbQueue_Blocked;
     list_add_tail(&p->p_next, &s->s_procQ);
     return 0;
 }
@@ -84,7 +148,7 @@ static bool tryFreeSemd(struct semd_t *const s) {
     debug_assert(NULL != s);
 
     if (emptyProcQ(&s->s_procQ)) {
-        // empty proc queue -> move sem back from semd_busy to semd_free.
+        // empty proc queue -> move sem back from its bucket to semd_free.
         list_del(&s->s_next);
         INIT_LIST_HEAD(&s->s_next);
         list_add_tail(&s->s_next, &semd_free);
@@ -107,7 +171,9 @@ struct pcb_t *removeBlocked(int *const key) {
     // thus we know removing a pcb_t from the queue must not return NULL.
     struct pcb_t *const out = removeProcQ(&s->s_procQ);
     assert(NULL != out);
+    debug_assert(PcbQueue_Blocked == out->p_queue);
     out->p_semkey = NULL;
+    out->p_queue = PcbQueue_None;
 
     tryFreeSemd(s);
     return out;
@@ -117,16 +183,23 @@ struct pcb_t *outBlocked(struct pcb_t *const p) {
     debug_assert(NULL != p);
 
     if (NULL != p->p_semkey) {
-        // A proc with a valid semkey (!= NULL) must have the relative sem.
-        struct semd_t *s = getSemd(p->p_semkey);
-        assert(NULL != s);
+        debug_assert(PcbQueue_Blocked == p->p_queue);
+        struct list_head *const next = p->p_next.next;
 
         // remove the proc from the queue and clean its semkey before return.
-        p->p_semkey = NULL;
         list_del(&p->p_next);
         INIT_LIST_HEAD(&p->p_next);
 
-        tryFreeSemd(s);
+        // A node of a proc is never empty while it is in a queue, thus if next is
+        // empty it is the queue of the sem, which has to be freed: no lookup needed.
+        if (list_empty(next)) {
+            struct semd_t *const s = container_of(next, struct semd_t, s_procQ);
+            debug_assert(p->p_semkey == s->s_key);
+            tryFreeSemd(s);
+        }
+
+        p->p_semkey = NULL;
+        p->p_queue = PcbQueue_None;
         return p;
     }
 
@@ -135,22 +208,11 @@ struct pcb_t *outBlocked(struct pcb_t *const p) {
 
 void outChildBlocked(struct pcb_t *const p) {
     debug_assert(NULL != p);
-    struct pcb_t *child = NULL, *sib = NULL;
+    struct pcb_t *next = NULL;
 
     // Removes procs from their relative queues in postorder traversal.
-    list_for_each_entry_reverse(child, &p->p_child, p_child) {
-        // Skipping the founder which is the only node of its progeny that
-        // has the parent outside the progeny itself. (see removeChild in pcb.c)
-        if (container_of(list_prev(&child->p_child), struct pcb_t, p_child) != child->p_parent) {
-            continue;
-        }
-
-        list_for_each_entry_reverse(sib, &child->p_sib, p_sib) {
-            outChildBlocked(sib);
-        }
-
-        outBlocked(child);
+    for (struct pcb_t *node = firstPostOrder(p); NULL != node; node = next) {
+        next = nextPostOrder(p, node);
+        outBlocked(node);
     }
-
-    outBlocked(p);
 }
@@ -1,5 +1,8 @@
 #include <assertions.h>
 #include <handlers.h>
+#include <scheduler.h>
+#include <input.h>
+#include <output.h>
 #include <types_bikaya.h>
 #include <core.h>
 
@@ -40,6 +43,9 @@ void core_boot(void) {
 
     initPcbs();
     initASL();
+    scheduler_init();
+    output_init();
+    input_init();
 }
 
 /**
@@ -80,55 +86,26 @@ void core_panic(void) {
     for(;;) {} // ensure noreturn and quiet compiler
 }
 
-unsigned machine_getInterruptLine(void) {
+unsigned machine_getInterruptLines(void) {
 #if defined(TARGET_UARM)
 #define CAUSE_IP(il)    (1U << ((il) + 24))
 #endif
 
     const unsigned cause = getCAUSE();
+    unsigned lines = 0;
 
     for (unsigned i = 0; i < N_INTERRUPT_LINES; ++i) {
         if (cause & CAUSE_IP(i)) {
-            return i;
+            lines |= 1U << i;
         }
     }
 
-    unreachable();
+    return lines;
 }
 
-unsigned machine_getInterruptDevice(const unsigned il) {
-    debug_assert(N_INTERRUPT_LINES > il);
-    const unsigned line = *((unsigned *) CDEV_BITMAP_ADDR(il));
-
-    for (unsigned i = 0; i < N_DEV_PER_IL; ++i) {
-        if (line & (1 << i)) {
-            return i;
-        }
-    }
-
-    unreachable();
-}
-
-ticks_t machine_getClockResolution(void) {
-    return *((ticks_t *) BUS_REG_TIME_SCALE);
-}
-
-ticks_t machine_getIntervalTimer(void) {
-    return *((ticks_t *) BUS_REG_TIMER);
-}
-
-ticks_t machine_resetIntervalTimer(void) {
-    const ticks_t timeLeft = machine_getIntervalTimer();
-    machine_setIntervalTimer(INTERVAL_TIMER_MAX);
-    return timeLeft;
-}   
-
-void machine_setIntervalTimer(const ticks_t ticks) {
-    *((ticks_t *) BUS_REG_TIMER) = ticks;
-}
-
-ticks_t machine_getTODLow(void) {
-    return *((ticks_t *) BUS_REG_TOD_LO);
+unsigned machine_getInterruptDevices(const unsigned il) {
+    debug_assert(DEV_IL_START <= il && N_INTERRUPT_LINES > il);
+    return *((volatile unsigned *) CDEV_BITMAP_ADDR(il)) & ((1U << N_DEV_PER_IL) - 1U);
 }
 
 void state_update(cpustate_t *const self, const struct StateConfig config) {
@@ -163,92 +140,21 @@ void state_update(cpustate_t *const self, const struct StateConfig config) {
  * but can't be implemented in the same way between uARM and uMPS architectures.
  */
 
-memaddr *state_programCounter(cpustate_t *const self) {
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return &self->pc;
-#elif defined(TARGET_UMPS)
-    return &self->pc_epc;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-memaddr state_getStackPointer(const cpustate_t *const self) {
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return self->sp;
-#elif defined(TARGET_UMPS)
-    return self->reg_sp;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-void state_setStackPointer(cpustate_t *const self, const memaddr sp) {
-    debug_assert(NULL != self);
+void core_idle(void) {
+    // the interval timer wakes up the sleepers (see scheduler.c)
 #if defined(TARGET_UARM)
-    self->sp = sp;
+    setSTATUS(STATUS_ENABLE_TIMER(STATUS_ENABLE_INT(getSTATUS())));
 #elif defined(TARGET_UMPS)
-    self->reg_sp = sp;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-sysno_t state_getSysNo(const cpustate_t *const self) {
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return self->a1;
-#elif defined(TARGET_UMPS)
-    return self->reg_a0;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-unsigned state_getSysArg1(const cpustate_t *const self) { 
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return self->a2;
-#elif defined(TARGET_UMPS)
-    return self->reg_a1;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-unsigned state_getSysArg2(const cpustate_t *const self) { 
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return self->a3;
-#elif defined(TARGET_UMPS)
-    return self->reg_a2;
+#define IRQ_MASK    (STATUS_IM(INTERRUPT_LINE_INTERVAL_TIMER) | STATUS_IM(INTERRUPT_LINE_DISK) | STATUS_IM(INTERRUPT_LINE_TAPE) | STATUS_IM(INTERRUPT_LINE_ETHERNET) | STATUS_IM(INTERRUPT_LINE_PRINTER) | STATUS_IM(INTERRUPT_LINE_TERMINAL))
+    setSTATUS((getSTATUS() & ~(STATUS_IM_MASK)) | IRQ_MASK | STATUS_IEc);
+#undef IRQ_MASK
 #else
 #error "Unknown target architecture"
 #endif
-}
 
-unsigned state_getSysArg3(const cpustate_t *const self) { 
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    return self->a4;
-#elif defined(TARGET_UMPS)
-    return self->reg_a3;
-#else
-#error "Unknown target architecture"
-#endif
-}
-
-void state_setSysReturn(cpustate_t *const self, const int value) {
-    debug_assert(NULL != self);
-#if defined(TARGET_UARM)
-    self->a1 = (unsigned) value;
-#elif defined(TARGET_UMPS)
-    self->reg_v0 = (unsigned) value;
-#else
-#error "Unknown target architecture"
-#endif
+    for(;;) {
+        WAIT();
+    }
 }
 
 static void enterKernelMode(cpustate_t *const self) {
@@ -1,178 +1,324 @@
 #include <core.h>
 #include <scheduler.h>
+#include <sleepq.h>
 #include <assertions.h>
 #include <const_bikaya.h>
+#include <input.h>
+#include <output.h>
 #include <handlers.h>
 
 #define ACK_COMMAND         1U
 #define READY_STATE         1U
 #define BUSY_STATE          3U
 
+#define LINE_BIT(il)        (1U << (il))
+#define DEVICE_LINES        (LINE_BIT(INTERRUPT_LINE_TERMINAL + 1) - LINE_BIT(INTERRUPT_LINE_DISK))
+
 static const devreg_t *const FIRST_DEVICE = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_DISK, 0);
 static const devreg_t *const FIRST_TERM = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0);
 static const devreg_t *const LAST_TERM = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, MACHINE_DEVICE_TERMINAL_NO);
 
+static struct InterruptStats interruptStats = { .entries = 0, .devices = 0, .maxDevices = 0 };
+
+/**
+ * Acknowledges the interrupt of a device waking up the process waiting for it,
+ * then starts the command of the next process waiting for the same channel, if any
+ * and if handOver is set (otherwise the channel is left free for the kernel).
+ */
+static void completeIO(const unsigned channel, unsigned *const commandRef, const unsigned status, const bool handOver) {
+    *commandRef = ACK_COMMAND;
+
+    const cpustate_t *const next = scheduler_completeIO(channel, status, handOver);
+    if (NULL != next) {
+        *commandRef = state_getSysArg1(next);
+    }
+}
+
+/**
+ * Acknowledges every pending interrupt of a device.
+ */
+static void serviceDevice(const unsigned il, const unsigned dev) {
+    devreg_t *const device = (devreg_t *) DEV_REG_ADDR(il, dev);
+
+    // Printers and terminal transmitters may be draining their output queue (see output.h):
+    // the characters written while a WAITIO was in flight go before the WAITIO queued after it.
+    if (INTERRUPT_LINE_TERMINAL != il) {
+        if (!output_complete(device)) {
+            completeIO(scheduler_ioChannel(device, false), &device->dtp.command, device->dtp.status, !output_pending(device));
+            output_start(device);
+        }
+
+        return;
+    }
+
+    if (READY_STATE != (device->term.transm_status & 0xFFU) && BUSY_STATE != (device->term.transm_status & 0xFFU)) {
+        if (!output_complete(device)) {
+            completeIO(scheduler_ioChannel(device, false), &device->term.transm_command, device->term.transm_status, !output_pending(device));
+            output_start(device);
+        }
+    }
+
+    // terminal receivers may be filling their receive ring (see input.h)
+    if (READY_STATE != (device->term.recv_status & 0xFFU) && BUSY_STATE != (device->term.recv_status & 0xFFU)) {
+        if (!input_complete(device)) {
+            completeIO(scheduler_ioChannel(device, true), &device->term.recv_command, device->term.recv_status, true);
+            input_start(device);
+        }
+    }
+}
+
 void handlers_interruptHandler(void) {
-    // The interrupt line must be obtained before reseting the timer
-    const unsigned il = machine_getInterruptLine();
+    // The interrupt lines must be obtained before reseting the timer
+    const unsigned lines = machine_getInterruptLines();
 
     const ticks_t timeLeft = machine_resetIntervalTimer();
     cpustate_t *oldState = MACHINE_OLD_INTERRUPT_AREA;
+    const bool timer = lines & LINE_BIT(INTERRUPT_LINE_INTERVAL_TIMER);
+    u32 serviced = 0;
 
 #if defined(TARGET_UARM)
     // restore PC to the correct instruction to be executed
     *state_programCounter(oldState) -= MACHINE_WORD_SIZE;
 #endif
 
-    switch (il) {
-        case INTERRUPT_LINE_INTERVAL_TIMER:
-            scheduler_contextSwitch(oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer());
-            unreachable();
-
-        case INTERRUPT_LINE_DISK:
-        case INTERRUPT_LINE_TAPE:
-        case INTERRUPT_LINE_ETHERNET:
-        case INTERRUPT_LINE_PRINTER: {
-            dtpreg_t *const device = (dtpreg_t *) DEV_REG_ADDR(il, machine_getInterruptDevice(il));
-            device->command = ACK_COMMAND;
-            break;
-        }
-
-        case INTERRUPT_LINE_TERMINAL: {
-            termreg_t *const device = (termreg_t *) DEV_REG_ADDR(il, machine_getInterruptDevice(il));
+    // The interval timer keeps its priority over the devices: it is raised by the end
+    // of the time slice and by the sleepers, which are woken up straight away.
+    const bool sliceExpired = timer && scheduler_sliceExpired();
+    if (timer) {
+        scheduler_wakeSleepers();
+    }
 
-            if (READY_STATE != (device->transm_status & 0xFFU) && BUSY_STATE != (device->transm_status & 0xFFU)) {
-                device->transm_command = ACK_COMMAND;
+    // Every pending device is acknowledged before leaving, including the ones that
+    // interrupt in the meantime, so that a burst of completions costs a single entry.
+    for (unsigned pending = lines & DEVICE_LINES; 0 != pending; pending = machine_getInterruptLines() & DEVICE_LINES) {
+        for (unsigned il = INTERRUPT_LINE_DISK; il <= INTERRUPT_LINE_TERMINAL; ++il) {
+            if (pending & LINE_BIT(il)) {
+                for (unsigned devices = machine_getInterruptDevices(il), dev = 0; 0 != devices; devices >>= 1, ++dev) {
+                    if (devices & 1U) {
+                        serviceDevice(il, dev);
+                        serviced += 1;
+                    }
+                }
             }
+        }
+    }
 
-            if (READY_STATE != (device->recv_status & 0xFFU) && BUSY_STATE != (device->recv_status & 0xFFU)) {
-                device->recv_command = ACK_COMMAND;
-            }
+    interruptStats.entries += 1;
+    interruptStats.devices += serviced;
+    interruptStats.maxDevices = (serviced > interruptStats.maxDevices) ? serviced : interruptStats.maxDevices;
 
-            break;
-        }
+    if (NULL == scheduler_getCurrentProcess()) {
+        // the processor was idle waiting for this interrupt.
+        scheduler_dispatch();
+        unreachable();
+    }
 
-        default:
-            unreachable();
+    // The expiry of the time slice has been detected before servicing the devices, it
+    // ends the slice now that the processes woken up by the sleepers and the devices
+    // above are ready to compete for the processor.
+    if (sliceExpired) {
+        scheduler_contextSwitch(oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer());
+        unreachable();
     }
 
     scheduler_resume(oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer(), NULL);
 }
 
-void handlers_sysbkHandler(void) {
-    const ticks_t timeLeft = machine_resetIntervalTimer();
-    cpustate_t *oldState = MACHINE_OLD_SYSBK_AREA;
-    struct TimeInfo timeInfo = { .userTime = NULL, .kernelTime = NULL, .wallclockTime = NULL };
+const struct InterruptStats *handlers_getInterruptStats(void) {
+    return &interruptStats;
+}
 
-#if defined(TARGET_UMPS)
-    // restore PC to the correct instruction to be executed
-    *state_programCounter(oldState) += MACHINE_WORD_SIZE;
-#endif
+static void getCpuTime(struct SyscallCall *const call) {
+    call->timeInfo.userTime = (ticks_t *) call->args[0];
+    call->timeInfo.kernelTime = (ticks_t *) call->args[1];
+    call->timeInfo.wallclockTime = (ticks_t *) call->args[2];
+}
 
-    switch (state_getSysNo(oldState)) {
-        case GETCPUTIME: {
-            timeInfo.userTime = (ticks_t *) state_getSysArg1(oldState);
-            timeInfo.kernelTime = (ticks_t *) state_getSysArg2(oldState);
-            timeInfo.wallclockTime = (ticks_t *) state_getSysArg3(oldState);
-            break;
-        }
+static void getCpuTime64(struct SyscallCall *const call) {
+    call->timeInfo.userTime64 = (ticks64_t *) call->args[0];
+    call->timeInfo.kernelTime64 = (ticks64_t *) call->args[1];
+    call->timeInfo.wallclockTime64 = (ticks64_t *) call->args[2];
+}
 
-        case TERMINATEPROCESS: {
-            void *const pid = (void *) state_getSysArg1(oldState);
-            scheduler_drop(pid, oldState);
-            break;
-        }
+static void createProcess(struct SyscallCall *const call) {
+    const cpustate_t *const childState = (const cpustate_t *) call->args[0];
+    const int priority = (int) call->args[1];
+    const void **const childPid = (const void **) call->args[2];
+    debug_assert(NULL != childState);
 
-        case GETPID: {
-            const void **const pid = (const void **) state_getSysArg1(oldState);
-            const void **const parentPid = (const void **) state_getSysArg2(oldState);
+    state_setSysReturn(call->state, scheduler_scheduleChild(childState, priority, childPid));
+}
 
-            if (NULL != pid) {
-               *pid = scheduler_getCurrentProcess();
-            }
+static void terminateProcess(struct SyscallCall *const call) {
+    scheduler_drop((void *) call->args[0]);
+}
 
-            if (NULL != parentPid) {
-               *parentPid = scheduler_getCurrentProcessParent();
-            }
+static void verhogen(struct SyscallCall *const call) {
+    int *const key = (int *) call->args[0];
+    debug_assert(NULL != key);
 
-            break;
-        }
+    scheduler_verhogen(key);
+}
 
-        case CREATEPROCESS: {
-            const cpustate_t *const childState = (const cpustate_t *) state_getSysArg1(oldState);
-            const int priority = (int) state_getSysArg2(oldState);
-            const void **const childPid = (const void **) state_getSysArg3(oldState);
-            debug_assert(NULL != childState);
+static void passeren(struct SyscallCall *const call) {
+    int *const key = (int *) call->args[0];
+    debug_assert(NULL != key);
 
-            state_setSysReturn(oldState, scheduler_scheduleChild(childState, priority, childPid));
-            break;
-        }
+    scheduler_passeren(key, call->state, call->timeLeft, handlers_syscallTime(call));
+}
 
-        case VERHOGEN: {
-            int *const key = (int *) state_getSysArg1(oldState);
-            debug_assert(NULL != key);
+static void waitIO(struct SyscallCall *const call) {
+    const unsigned command = call->args[0];
+    devreg_t *const device = (devreg_t *) call->args[1];
+    const int subdevice = (int) call->args[2];
+
+    unsigned *commandRef = NULL;
+    unsigned channel = 0;
+
+    if (FIRST_DEVICE <= device && device < FIRST_TERM) {
+        commandRef = &device->dtp.command;
+        channel = scheduler_ioChannel(device, false);
+    } else if (FIRST_TERM <= device && device < LAST_TERM) {
+        commandRef = (0 == subdevice) ? &device->term.transm_command : &device->term.recv_command;
+        channel = scheduler_ioChannel(device, 0 != subdevice);
+    } else {
+        unreachable();
+    }
 
-            scheduler_verhogen(key);
-            break;
-        }
+    // The command is issued at once if the device is free, otherwise it is issued on the
+    // completion of the ones that precede it (see completeIO).
+    // NOTE: the data0 register of DTP devices is written by the caller before WAITIO,
+    //       so concurrent requests to the same DTP device must be serialized by the callers.
+    // NOTE: the same goes for the output queue of a printer (WRITE and SPOOL), which writes
+    //       data0 as well: a WAITIO on a printer with characters queued is refused (-1) and
+    //       callers must not mix both on the same printer. The command of a terminal
+    //       transmitter carries its character, so its WAITIO just waits for the queue to drain.
+    if (FIRST_TERM > device && output_pending(device)) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
 
-        case PASSEREN: {
-            int *const key = (int *) state_getSysArg1(oldState);
-            debug_assert(NULL != key);
+    if (scheduler_startIO(channel)) {
+        *commandRef = command;
+    }
 
-            scheduler_passeren(key, oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer());
-            break;
-        }
+    // the status is set as return value when the process is woken up.
+    scheduler_waitIO(channel, call->state, call->timeLeft, handlers_syscallTime(call));
+    unreachable();
+}
 
-        case SPECPASSUP: {
-            const int sysReturnValue = scheduler_registerCustomHandler((enum ExcType) state_getSysArg1(oldState),
-                                                                       (cpustate_t *) state_getSysArg2(oldState),
-                                                                       (cpustate_t *) state_getSysArg3(oldState));
-            state_setSysReturn(oldState, sysReturnValue);
-            if (0 != sysReturnValue) {
-                scheduler_drop(NULL, oldState);
-                unreachable();
-            }
+static void specPassup(struct SyscallCall *const call) {
+    const int sysReturnValue = scheduler_registerCustomHandler((enum ExcType) call->args[0],
+                                                               (cpustate_t *) call->args[1],
+                                                               (cpustate_t *) call->args[2]);
+    state_setSysReturn(call->state, sysReturnValue);
+    if (0 != sysReturnValue) {
+        scheduler_drop(NULL);
+        unreachable();
+    }
+}
 
-            break;
-        }
+static void getProcessIds(struct SyscallCall *const call) {
+    const void **const pid = (const void **) call->args[0];
+    const void **const parentPid = (const void **) call->args[1];
 
-        case WAITIO: {
-            const unsigned command = state_getSysArg1(oldState);
-            devreg_t *const device = (devreg_t *) state_getSysArg2(oldState);
-            const int subdevice = state_getSysArg3(oldState);
-
-            unsigned *statusRef = NULL;
-            unsigned *commandRef = NULL;
-
-            if (FIRST_DEVICE <= device && device < FIRST_TERM) {
-                statusRef = &device->dtp.status;
-                commandRef = &device->dtp.command;
-            } else if (FIRST_TERM <= device && device < LAST_TERM) {
-                if (0 == subdevice) {
-                    statusRef = &device->term.transm_status;
-                    commandRef = &device->term.transm_command;
-                } else {
-                    statusRef = &device->term.recv_status;
-                    commandRef = &device->term.recv_command;
-                }
-            } else {
-                unreachable();
-            }
+    if (NULL != pid) {
+       *pid = scheduler_getCurrentProcess();
+    }
 
-            *commandRef = command;
-            while (BUSY_STATE == (*statusRef & 0xFFU));
-            state_setSysReturn(oldState, *statusRef);
+    if (NULL != parentPid) {
+       *parentPid = scheduler_getCurrentProcessParent();
+    }
+}
 
-            break;
-        }
+static void sleep(struct SyscallCall *const call) {
+    const u32 micros = call->args[0];
+
+    if (SLEEPQ_MAX_DELAY / machine_getClockResolution() < micros) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
+
+    state_setSysReturn(call->state, 0);
+    if (0 < micros) {
+        scheduler_sleep(micros * machine_getClockResolution(), call->state, call->timeLeft, handlers_syscallTime(call));
+        unreachable();
+    }
+}
 
-        default:
-            scheduler_callSysbkHandler(oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer());
-            unreachable();
+// Kernel services indexed by system call number; empty entries are passed up to the process.
+static struct Syscall syscalls[SYSCALL_TABLE_SIZE] = {
+    [GETCPUTIME]       = { .service=getCpuTime,       .argc=3, .flags=SyscallFlag_None },
+    [CREATEPROCESS]    = { .service=createProcess,    .argc=3, .flags=SyscallFlag_MayReschedule },
+    [TERMINATEPROCESS] = { .service=terminateProcess, .argc=1, .flags=SyscallFlag_MayBlock },
+    [VERHOGEN]         = { .service=verhogen,         .argc=1, .flags=SyscallFlag_MayReschedule },
+    [PASSEREN]         = { .service=passeren,         .argc=1, .flags=SyscallFlag_MayBlock },
+    [WAITIO]           = { .service=waitIO,           .argc=3, .flags=SyscallFlag_MayBlock },
+    [SPECPASSUP]       = { .service=specPassup,       .argc=3, .flags=SyscallFlag_MayBlock },
+    [GETPID]           = { .service=getProcessIds,    .argc=2, .flags=SyscallFlag_None },
+    [SLEEP]            = { .service=sleep,            .argc=1, .flags=SyscallFlag_MayBlock },
+    [GETCPUTIME64]     = { .service=getCpuTime64,     .argc=3, .flags=SyscallFlag_None },
+};
+
+bool handlers_registerSyscall(const sysno_t sysNo, const struct Syscall syscall) {
+    debug_assert(NULL != syscall.service);
+    debug_assert(3 >= syscall.argc);
+
+    if (SYSCALL_TABLE_SIZE <= sysNo || NULL != syscalls[sysNo].service) {
+        return false;
     }
 
-    scheduler_resume(oldState, timeLeft, INTERVAL_TIMER_MAX - machine_getIntervalTimer(), &timeInfo);
+    syscalls[sysNo] = syscall;
+    return true;
+}
+
+void handlers_sysbkHandler(void) {
+    // The interval timer is not reset: the time slice of the caller keeps running
+    // and the time spent here is measured against it (see handlers_syscallTime).
+    const ticks_t timeLeft = machine_getIntervalTimer();
+    cpustate_t *oldState = MACHINE_OLD_SYSBK_AREA;
+
+#if defined(TARGET_UMPS)
+    // restore PC to the correct instruction to be executed
+    *state_programCounter(oldState) += MACHINE_WORD_SIZE;
+#endif
+
+    const sysno_t sysNo = state_getSysNo(oldState);
+    const struct Syscall *const syscall = (SYSCALL_TABLE_SIZE > sysNo) ? &syscalls[sysNo] : NULL;
+
+    if (NULL == syscall || NULL == syscall->service) {
+        scheduler_callSysbkHandler(oldState, timeLeft, timeLeft - machine_getIntervalTimer());
+        unreachable();
+    }
+
+    struct SyscallCall call = {
+        .state=oldState,
+        .timeLeft=timeLeft,
+        .timeInfo={
+            .userTime=NULL, .kernelTime=NULL, .wallclockTime=NULL,
+            .userTime64=NULL, .kernelTime64=NULL, .wallclockTime64=NULL,
+        },
+    };
+
+    // only the declared arguments are decoded
+    switch (syscall->argc) {
+        case 3: call.args[2] = state_getSysArg3(oldState); /* FALLTHROUGH */
+        case 2: call.args[1] = state_getSysArg2(oldState); /* FALLTHROUGH */
+        case 1: call.args[0] = state_getSysArg1(oldState); /* FALLTHROUGH */
+        default: break;
+    }
+
+    // Services that block never get back here. The caller is resumed without touching
+    // the timer unless another process has been made ready meanwhile: then the regular
+    // path checks for preemption and arms the time slice. Services flagged as none
+    // can not make any process ready, so the check is skipped for them.
+    syscall->service(&call);
+
+    if (SyscallFlag_None == syscall->flags || scheduler_canResumeFast()) {
+        scheduler_resumeFast(oldState, timeLeft, &call.timeInfo);
+    } else {
+        scheduler_resume(oldState, timeLeft, handlers_syscallTime(&call), &call.timeInfo);
+    }
 }
 
 void handlers_TLBHandler(void) {
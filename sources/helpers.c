@@ -1,4 +1,5 @@
 #include <helpers.h>
+#include <assertions.h>
 
 const u32 U32_TEN = 10U;
 
@@ -20,3 +21,27 @@ bool u32_to_base10(bool (*f)(char), const u32 n) {
 
     return r && f('0' + (n % U32_TEN));
 }
+
+u32 u32_clz(u32 n) {
+    u32 r = 0;
+
+    if (0 == n) {
+        return 32;
+    }
+
+    if (0 == (n & 0xFFFF0000U)) { r += 16; n <<= 16; }
+    if (0 == (n & 0xFF000000U)) { r += 8;  n <<= 8;  }
+    if (0 == (n & 0xF0000000U)) { r += 4;  n <<= 4;  }
+    if (0 == (n & 0xC0000000U)) { r += 2;  n <<= 2;  }
+    if (0 == (n & 0x80000000U)) { r += 1; }
+
+    return r;
+}
+
+u32 u32_random(u32 *const seed, const u32 bound) {
+    debug_assert(NULL != seed);
+    debug_assert(0 < bound);
+
+    *seed = *seed * 1103515245U + 12345U;
+    return (*seed >> 16) % bound;
+}
@@ -0,0 +1,184 @@
+#include <primitive_types.h>
+#include <assertions.h>
+#include <const_bikaya.h>
+#include <core.h>
+#include <handlers.h>
+#include <scheduler.h>
+#include <input.h>
+
+// NOTE: keep this portion of code free of arch-specific code!
+
+#define RING_MASK       (INPUT_RING_SIZE - 1U)
+
+static_assert(0 == (INPUT_RING_SIZE & RING_MASK), "the size of the receive rings must be a power of two");
+
+// Receive ring of a terminal: head and tail are free running, their difference is the number of buffered characters.
+struct InputRing {
+    u32 head;               // index of the next character to be read
+    u32 tail;               // index of the next free slot
+    u32 lines;              // number of newlines in the ring
+    bool enabled;           // true if the receiver has to be kept busy
+    bool receiving;         // true while a receive of the ring is in flight
+    bool failed;            // true if the latest receive failed and no reader has been told yet
+    int line;               // semaphore on which the readers wait for a line (always 0)
+    char chars[INPUT_RING_SIZE];
+};
+
+static struct InputRing rings[MACHINE_DEVICE_TERMINAL_NO];
+
+static struct InputRing *ringOf(const devreg_t *device);
+static void receive(devreg_t *device);
+static bool received(const devreg_t *device, char *c);
+
+static u32 buffered(const struct InputRing *const r) {
+    return r->tail - r->head;
+}
+
+static bool isNewline(const char c) {
+    return '\n' == c;
+}
+
+static void readlineService(struct SyscallCall *const call) {
+    devreg_t *const device = (devreg_t *) call->args[0];
+    char *const buf = (char *) call->args[1];
+    const u32 size = call->args[2];
+    struct InputRing *const r = ringOf(device);
+
+    if (NULL == r || NULL == buf || 0 == size) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
+
+    // after an error the reader gets what is left (if anything) without waiting.
+    const bool failed = r->failed;
+    r->failed = false;
+
+    if (failed && 0 == buffered(r)) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
+
+    if (!failed && 0 == r->lines && INPUT_RING_SIZE != buffered(r)) {
+        // the caller tries again once a line is complete (or the ring is full).
+        r->enabled = true;
+        input_start(device);
+        state_setSysReturn(call->state, 0);
+        scheduler_passeren(&r->line, call->state, call->timeLeft, handlers_syscallTime(call));
+        unreachable();
+    }
+
+    u32 n = 0;
+    bool eol = false;
+
+    while (n < size && 0 < buffered(r) && !eol) {
+        const char c = r->chars[(r->head++) & RING_MASK];
+        buf[n++] = c;
+        eol = isNewline(c);
+    }
+
+    r->lines -= eol ? 1 : 0;
+    input_start(device);
+    state_setSysReturn(call->state, (int) n);
+}
+
+void input_init(void) {
+    for (unsigned i = 0; i < MACHINE_DEVICE_TERMINAL_NO; ++i) {
+        rings[i].head = rings[i].tail = rings[i].lines = 0;
+        rings[i].enabled = rings[i].receiving = rings[i].failed = false;
+        rings[i].line = 0;
+    }
+
+    assert(handlers_registerSyscall(READLINE, (struct Syscall) {
+        .service=readlineService, .argc=3, .flags=SyscallFlag_MayBlock
+    }));
+}
+
+bool input_complete(devreg_t *const device) {
+    struct InputRing *const r = ringOf(device);
+    char c = 0;
+
+    if (NULL == r || !r->receiving) {
+        return false;
+    }
+
+    r->receiving = false;
+
+    if (!received(device, &c)) {
+        // the receiver is left alone until the next read, the readers get an error.
+        r->enabled = false;
+        r->failed = true;
+        scheduler_wakeAll(&r->line);
+        return false;
+    }
+
+    debug_assert(INPUT_RING_SIZE > buffered(r));
+    r->chars[(r->tail++) & RING_MASK] = c;
+    r->lines += isNewline(c) ? 1 : 0;
+
+    if (isNewline(c) || INPUT_RING_SIZE == buffered(r)) {
+        scheduler_wakeAll(&r->line);
+    }
+
+    // A WAITIO queued on the receiver takes the channel over: the ring is
+    // restarted by input_start once the channel is free again.
+    if (INPUT_RING_SIZE == buffered(r) || scheduler_hasIOWaiters(scheduler_ioChannel(device, true))) {
+        return false;
+    }
+
+    r->receiving = true;
+    receive(device);
+    return true;
+}
+
+void input_start(devreg_t *const device) {
+    struct InputRing *const r = ringOf(device);
+
+    if (NULL != r && r->enabled && !r->receiving && INPUT_RING_SIZE != buffered(r)
+        && scheduler_startKernelIO(scheduler_ioChannel(device, true))) {
+        r->receiving = true;
+        receive(device);
+    }
+}
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * As for term.c, uARM and uMPS share the same device registers.
+ */
+
+#if !(defined(TARGET_UARM) || defined(TARGET_UMPS))
+#error "Unknown target architecture"
+#endif
+
+#define RAW_STATUS_OK        5U
+#define CMD_ACK              1U
+#define CMD_RECEIVE          2U
+#define BYTE_OFFSET          8U
+#define BYTE_MASK            0xFFU
+
+static struct InputRing *ringOf(const devreg_t *const device) {
+    const devreg_t *const firstTerm = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0);
+
+    if (firstTerm <= device && device < firstTerm + MACHINE_DEVICE_TERMINAL_NO) {
+        return &rings[device - firstTerm];
+    }
+
+    return NULL;
+}
+
+static void receive(devreg_t *const device) {
+    device->term.recv_command = CMD_ACK;
+    device->term.recv_command = CMD_RECEIVE;
+}
+
+static bool received(const devreg_t *const device, char *const c) {
+    //  | OPAQUE | OPAQUE |  CHAR  | STATUS |
+    // 31       23       15        7        0
+    const unsigned status = device->term.recv_status;
+    *c = (char) ((status >> BYTE_OFFSET) & BYTE_MASK);
+    return RAW_STATUS_OK == (status & BYTE_MASK);
+}
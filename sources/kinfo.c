@@ -0,0 +1,51 @@
+#include <primitive_types.h>
+#include <core.h>
+#include <kinfo.h>
+
+struct KernelInfo kinfo_page = { .sequence = 0 };
+
+void kinfo_publish(const void *const pid, const void *const parentPid,
+                   const ticks64_t userTime, const ticks64_t kernelTime, const ticks64_t startTime, const ticks_t resumeTimer) {
+    kinfo_page.pid = pid;
+    kinfo_page.parentPid = parentPid;
+    kinfo_page.userTime = userTime;
+    kinfo_page.kernelTime = kernelTime;
+    kinfo_page.startTime = startTime;
+    kinfo_page.resumeTimer = resumeTimer;
+    kinfo_page.sequence += 1;
+}
+
+const void *kinfo_getPid(void) {
+    return KINFO_PAGE->pid;
+}
+
+const void *kinfo_getParentPid(void) {
+    return KINFO_PAGE->parentPid;
+}
+
+void kinfo_getCpuTime(ticks_t *const userTime, ticks_t *const kernelTime, ticks_t *const wallclockTime) {
+    ticks64_t user, kernel, wallclock;
+    kinfo_getCpuTime64(&user, &kernel, &wallclock);
+
+    if (NULL != userTime) *userTime = (ticks_t) user;
+    if (NULL != kernelTime) *kernelTime = (ticks_t) kernel;
+    if (NULL != wallclockTime) *wallclockTime = (ticks_t) wallclock;
+}
+
+void kinfo_getCpuTime64(ticks64_t *const userTime, ticks64_t *const kernelTime, ticks64_t *const wallclockTime) {
+    const volatile struct KernelInfo *const page = KINFO_PAGE;
+    u32 sequence;
+    ticks64_t user, kernel, start;
+
+    // If the process is preempted while reading, the page may be rewritten: read it again.
+    do {
+        sequence = page->sequence;
+        user = page->userTime + (page->resumeTimer - machine_getIntervalTimer());
+        kernel = page->kernelTime;
+        start = page->startTime;
+    } while (sequence != page->sequence);
+
+    if (NULL != userTime) *userTime = user;
+    if (NULL != kernelTime) *kernelTime = kernel;
+    if (NULL != wallclockTime) *wallclockTime = machine_getTOD64() - start;
+}
@@ -1,10 +1,140 @@
+#include <primitive_types.h>
 #include <assertions.h>
 #include <memory.h>
 
+// words are accessed through a type that may alias any other one
+typedef u32 __attribute__((__may_alias__)) word_t;
+
+#define WORD_MASK       (sizeof(word_t) - 1U)
+#define BLOCK_WORDS     8U
+#define BLOCK_SIZE      (BLOCK_WORDS * sizeof(word_t))
+
+static inline bool isWordAligned(const void *const ptr) {
+    return 0 == ((u32) ptr & WORD_MASK);
+}
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * copyBlocks and clearBlocks move blocks of BLOCK_WORDS words between word
+ * aligned buffers: uARM uses multi-register transfers (LDM/STM), while uMPS
+ * uses unrolled loads and stores, issuing all the loads of a block before
+ * the stores so that no load delay slot is ever wasted.
+ */
+
+static void copyBlocks(word_t *d, const word_t *s, usize blocks) {
+#if defined(TARGET_UARM)
+    while (blocks--) {
+        __asm__ volatile (
+            "ldmia %[s]!, {r3-r10}\n\t"
+            "stmia %[d]!, {r3-r10}"
+            : [d] "+r" (d), [s] "+r" (s)
+            :
+            : "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "memory"
+        );
+    }
+#elif defined(TARGET_UMPS)
+    while (blocks--) {
+        word_t t0, t1, t2, t3, t4, t5, t6, t7;
+        __asm__ volatile (
+            "lw %[t0], 0(%[s])\n\t"
+            "lw %[t1], 4(%[s])\n\t"
+            "lw %[t2], 8(%[s])\n\t"
+            "lw %[t3], 12(%[s])\n\t"
+            "lw %[t4], 16(%[s])\n\t"
+            "lw %[t5], 20(%[s])\n\t"
+            "lw %[t6], 24(%[s])\n\t"
+            "lw %[t7], 28(%[s])\n\t"
+            "sw %[t0], 0(%[d])\n\t"
+            "sw %[t1], 4(%[d])\n\t"
+            "sw %[t2], 8(%[d])\n\t"
+            "sw %[t3], 12(%[d])\n\t"
+            "sw %[t4], 16(%[d])\n\t"
+            "sw %[t5], 20(%[d])\n\t"
+            "sw %[t6], 24(%[d])\n\t"
+            "sw %[t7], 28(%[d])"
+            : [t0] "=&r" (t0), [t1] "=&r" (t1), [t2] "=&r" (t2), [t3] "=&r" (t3),
+              [t4] "=&r" (t4), [t5] "=&r" (t5), [t6] "=&r" (t6), [t7] "=&r" (t7)
+            : [d] "r" (d), [s] "r" (s)
+            : "memory"
+        );
+        d += BLOCK_WORDS;
+        s += BLOCK_WORDS;
+    }
+#else
+#error "Unknown target architecture"
+#endif
+}
+
+static void clearBlocks(word_t *d, usize blocks) {
+#if defined(TARGET_UARM)
+    while (blocks--) {
+        __asm__ volatile (
+            "mov r3, #0\n\t"
+            "mov r4, #0\n\t"
+            "mov r5, #0\n\t"
+            "mov r6, #0\n\t"
+            "stmia %[d]!, {r3-r6}\n\t"
+            "stmia %[d]!, {r3-r6}"
+            : [d] "+r" (d)
+            :
+            : "r3", "r4", "r5", "r6", "memory"
+        );
+    }
+#elif defined(TARGET_UMPS)
+    while (blocks--) {
+        __asm__ volatile (
+            "sw $zero, 0(%[d])\n\t"
+            "sw $zero, 4(%[d])\n\t"
+            "sw $zero, 8(%[d])\n\t"
+            "sw $zero, 12(%[d])\n\t"
+            "sw $zero, 16(%[d])\n\t"
+            "sw $zero, 20(%[d])\n\t"
+            "sw $zero, 24(%[d])\n\t"
+            "sw $zero, 28(%[d])"
+            :
+            : [d] "r" (d)
+            : "memory"
+        );
+        d += BLOCK_WORDS;
+    }
+#else
+#error "Unknown target architecture"
+#endif
+}
+
+/**
+ * From here on there is no arch-dependant code.
+ */
+
 void memclr(void *const ptr, usize len) {
     debug_assert(NULL != ptr);
-
     u8 *p = ptr;
+
+    // byte-wise head up to the first word boundary
+    for (; 0 < len && !isWordAligned(p); --len) {
+        *(p++) = 0;
+    }
+
+    if (sizeof(word_t) <= len) {
+        word_t *w = (word_t *) p;
+
+        clearBlocks(w, len / BLOCK_SIZE);
+        w += (len / BLOCK_SIZE) * BLOCK_WORDS;
+        len %= BLOCK_SIZE;
+
+        for (; sizeof(word_t) <= len; len -= sizeof(word_t)) {
+            *(w++) = 0;
+        }
+
+        p = (u8 *) w;
+    }
+
+    // byte-wise tail
     while (len--) {
         *(p++) = 0;
     }
@@ -16,6 +146,30 @@ void memdup(void *const destination, const void *const source, usize len) {
 
     u8 *d = destination;
     const u8 *s = source;
+
+    // word-wise copy is possible only if both buffers can be aligned at once
+    if (0 == (((u32) d ^ (u32) s) & WORD_MASK)) {
+        for (; 0 < len && !isWordAligned(d); --len) {
+            *(d++) = *(s++);
+        }
+
+        word_t *dw = (word_t *) d;
+        const word_t *sw = (const word_t *) s;
+
+        copyBlocks(dw, sw, len / BLOCK_SIZE);
+        dw += (len / BLOCK_SIZE) * BLOCK_WORDS;
+        sw += (len / BLOCK_SIZE) * BLOCK_WORDS;
+        len %= BLOCK_SIZE;
+
+        for (; sizeof(word_t) <= len; len -= sizeof(word_t)) {
+            *(dw++) = *(sw++);
+        }
+
+        d = (u8 *) dw;
+        s = (const u8 *) sw;
+    }
+
+    // byte-wise tail (or whole copy of misaligned buffers)
     while (len--) {
         *(d++) = *(s++);
     }
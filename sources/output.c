@@ -0,0 +1,274 @@
+#include <primitive_types.h>
+#include <assertions.h>
+#include <const_bikaya.h>
+#include <core.h>
+#include <handlers.h>
+#include <scheduler.h>
+#include <output.h>
+
+// NOTE: keep this portion of code free of arch-specific code!
+
+#define QUEUE_MASK      (OUTPUT_QUEUE_SIZE - 1U)
+#define JOBS_MASK       (OUTPUT_JOBS_NO - 1U)
+#define QUEUES_NO       (MACHINE_DEVICE_TERMINAL_NO + MACHINE_DEVICE_PRINTER_NO)
+
+static_assert(0 == (OUTPUT_QUEUE_SIZE & QUEUE_MASK), "the size of the output queues must be a power of two");
+static_assert(0 == (OUTPUT_JOBS_NO & JOBS_MASK), "the number of jobs per queue must be a power of two");
+
+// Print job: the characters of the queue up to end (excluded) and the semaphore to signal once they have been sent.
+struct OutputJob {
+    u32 end;
+    int *semaphore;
+};
+
+// Output queue of a device: head and tail are free running, their difference is the number of queued characters.
+struct OutputQueue {
+    u32 head;               // index of the next character to be sent
+    u32 tail;               // index of the next free slot
+    bool sending;           // true while a character of the queue is in flight
+    int room;               // semaphore on which the writers wait for room (always 0)
+    u32 jobsHead;           // index of the oldest job in flight (free running as well)
+    u32 jobsTail;           // index of the next free job slot
+    struct OutputJob jobs[OUTPUT_JOBS_NO];
+    char chars[OUTPUT_QUEUE_SIZE];
+};
+
+static struct OutputQueue queues[QUEUES_NO];
+
+// semaphore on which the spooler clients wait for a printer that can take their job (always 0)
+static int spoolerRoom = 0;
+
+static struct OutputQueue *queueOf(const devreg_t *device);
+static devreg_t *printerOf(unsigned printer);
+static bool isInstalled(const devreg_t *device);
+static void send(devreg_t *device, char c);
+
+static u32 queued(const struct OutputQueue *const q) {
+    return q->tail - q->head;
+}
+
+/**
+ * Sends the character at the head of the queue of a device whose channel is owned by the queue.
+ */
+static void sendHead(devreg_t *const device, struct OutputQueue *const q) {
+    debug_assert(0 < queued(q));
+    q->sending = true;
+    send(device, q->chars[q->head & QUEUE_MASK]);
+}
+
+static u32 jobs(const struct OutputQueue *const q) {
+    return q->jobsTail - q->jobsHead;
+}
+
+/**
+ * Appends the given characters to the queue (there must be room for them).
+ */
+static void enqueue(struct OutputQueue *const q, const char *const buf, const u32 len) {
+    debug_assert(OUTPUT_QUEUE_SIZE - queued(q) >= len);
+
+    for (u32 i = 0; i < len; ++i) {
+        q->chars[(q->tail + i) & QUEUE_MASK] = buf[i];
+    }
+
+    q->tail += len;
+}
+
+/**
+ * Signals the jobs of the queue whose characters have all been sent.
+ */
+static void completeJobs(struct OutputQueue *const q) {
+    bool completed = false;
+
+    for (; 0 < jobs(q) && q->jobs[q->jobsHead & JOBS_MASK].end == q->head; q->jobsHead += 1) {
+        int *const semaphore = q->jobs[q->jobsHead & JOBS_MASK].semaphore;
+
+        if (NULL != semaphore) {
+            scheduler_verhogen(semaphore);
+        }
+
+        completed = true;
+    }
+
+    if (completed) {
+        scheduler_wakeAll(&spoolerRoom);
+    }
+}
+
+static void spoolService(struct SyscallCall *const call) {
+    const char *const buf = (const char *) call->args[0];
+    const u32 len = call->args[1];
+    int *const semaphore = (int *) call->args[2];
+
+    if (NULL == buf || 0 == len || OUTPUT_QUEUE_SIZE < len) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
+
+    // The job goes to the installed printer with the fewest characters queued among the
+    // ones that can take it whole, so that queued jobs are spread over every printer.
+    unsigned printer = MACHINE_DEVICE_PRINTER_NO;
+    struct OutputQueue *q = NULL;
+
+    for (unsigned i = 0; i < MACHINE_DEVICE_PRINTER_NO; ++i) {
+        struct OutputQueue *const candidate = queueOf(printerOf(i));
+
+        if (isInstalled(printerOf(i)) && OUTPUT_JOBS_NO > jobs(candidate)
+            && OUTPUT_QUEUE_SIZE - queued(candidate) >= len && (NULL == q || queued(candidate) < queued(q))) {
+            printer = i;
+            q = candidate;
+        }
+    }
+
+    if (NULL == q) {
+        // the caller tries again once some job has been completed.
+        state_setSysReturn(call->state, 0);
+        scheduler_passeren(&spoolerRoom, call->state, call->timeLeft, handlers_syscallTime(call));
+        unreachable();
+    }
+
+    enqueue(q, buf, len);
+    q->jobs[q->jobsTail & JOBS_MASK] = (struct OutputJob) { .end=q->tail, .semaphore=semaphore };
+    q->jobsTail += 1;
+
+    output_start(printerOf(printer));
+    state_setSysReturn(call->state, (int) (printer + 1));
+}
+
+static void writeService(struct SyscallCall *const call) {
+    devreg_t *const device = (devreg_t *) call->args[0];
+    const char *const buf = (const char *) call->args[1];
+    const u32 len = call->args[2];
+    struct OutputQueue *const q = queueOf(device);
+
+    if (NULL == q || (NULL == buf && 0 < len)) {
+        state_setSysReturn(call->state, -1);
+        return;
+    }
+
+    if (0 < len && OUTPUT_QUEUE_SIZE == queued(q)) {
+        // the caller tries again once the queue has been drained to half of its size.
+        state_setSysReturn(call->state, 0);
+        scheduler_passeren(&q->room, call->state, call->timeLeft, handlers_syscallTime(call));
+        unreachable();
+    }
+
+    const u32 room = OUTPUT_QUEUE_SIZE - queued(q);
+    const u32 n = (len < room) ? len : room;
+
+    enqueue(q, buf, n);
+    output_start(device);
+    state_setSysReturn(call->state, (int) n);
+}
+
+void output_init(void) {
+    for (unsigned i = 0; i < QUEUES_NO; ++i) {
+        queues[i].head = queues[i].tail = 0;
+        queues[i].sending = false;
+        queues[i].room = 0;
+        queues[i].jobsHead = queues[i].jobsTail = 0;
+    }
+
+    spoolerRoom = 0;
+
+    assert(handlers_registerSyscall(WRITE, (struct Syscall) {
+        .service=writeService, .argc=3, .flags=SyscallFlag_MayBlock
+    }));
+
+    assert(handlers_registerSyscall(SPOOL, (struct Syscall) {
+        .service=spoolService, .argc=3, .flags=SyscallFlag_MayBlock
+    }));
+}
+
+bool output_complete(devreg_t *const device) {
+    struct OutputQueue *const q = queueOf(device);
+
+    if (NULL == q || !q->sending) {
+        return false;
+    }
+
+    q->sending = false;
+    q->head += 1;
+    completeJobs(q);
+
+    if (OUTPUT_QUEUE_SIZE / 2 == queued(q)) {
+        scheduler_wakeAll(&q->room);
+    }
+
+    if (0 < queued(q)) {
+        sendHead(device, q);
+        return true;
+    }
+
+    return false;
+}
+
+bool output_pending(const devreg_t *const device) {
+    const struct OutputQueue *const q = queueOf(device);
+    return NULL != q && 0 < queued(q);
+}
+
+void output_start(devreg_t *const device) {
+    struct OutputQueue *const q = queueOf(device);
+
+    if (NULL != q && !q->sending && 0 < queued(q) && scheduler_startKernelIO(scheduler_ioChannel(device, false))) {
+        sendHead(device, q);
+    }
+}
+
+/**
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ * !!!!    ATTENTION    !!!!
+ * !!!!!!!!!!!!!!!!!!!!!!!!!
+ *
+ * The code below contains arch-dependant code!
+ *
+ * As for term.c and printer.c, uARM and uMPS share the same device registers.
+ */
+
+#if !(defined(TARGET_UARM) || defined(TARGET_UMPS))
+#error "Unknown target architecture"
+#endif
+
+#define CMD_ACK              1U
+#define CMD_TRANSMIT         2U
+#define CMD_PRINT            2U
+#define BYTE_OFFSET          8U
+#define BYTE_MASK            0xFFU
+#define RAW_STATUS_ABSENT    0U
+
+static struct OutputQueue *queueOf(const devreg_t *const device) {
+    const devreg_t *const firstTerm = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0);
+    const devreg_t *const firstPrinter = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_PRINTER, 0);
+
+    if (firstTerm <= device && device < firstTerm + MACHINE_DEVICE_TERMINAL_NO) {
+        return &queues[device - firstTerm];
+    }
+
+    if (firstPrinter <= device && device < firstPrinter + MACHINE_DEVICE_PRINTER_NO) {
+        return &queues[MACHINE_DEVICE_TERMINAL_NO + (device - firstPrinter)];
+    }
+
+    return NULL;
+}
+
+static devreg_t *printerOf(const unsigned printer) {
+    debug_assert(MACHINE_DEVICE_PRINTER_NO > printer);
+    return (devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_PRINTER, printer);
+}
+
+static bool isInstalled(const devreg_t *const device) {
+    return RAW_STATUS_ABSENT != (device->dtp.status & BYTE_MASK);
+}
+
+static void send(devreg_t *const device, const char c) {
+    const devreg_t *const firstTerm = (const devreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, 0);
+
+    if (firstTerm <= device) {
+        device->term.transm_command = CMD_ACK;
+        device->term.transm_command = (((unsigned) (u8) c) << BYTE_OFFSET) | CMD_TRANSMIT;
+    } else {
+        device->dtp.command = CMD_ACK;
+        device->dtp.data0 = (u8) c;
+        device->dtp.command = CMD_PRINT;
+    }
+}
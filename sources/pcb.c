@@ -3,39 +3,130 @@
 #include <memory.h>
 #include <const_bikaya.h>
 #include <listx.h>
+#include <slab.h>
 #include <pcb.h>
 
-static struct pcb_t pcb_table[MAX_PROC_NO];
+// number of pcbs in each slab
+#define PCB_PER_SLAB    ((SLAB_SIZE - sizeof(struct PcbSlab *) - sizeof(usize)) / (sizeof(struct pcb_t) + sizeof(struct pcb_cold_t)))
+
+/**
+ * Slab of PCBs: slabs are SLAB_SIZE aligned so that the slab of a pcb is
+ * found masking its address, then the PID is derived from the slab index
+ * and the index of the pcb inside the slab.
+ * The hot and the cold parts of the pcbs are kept in two parallel arrays.
+ */
+struct PcbSlab {
+    struct PcbSlab *next;
+    usize index;
+    struct pcb_t pcbs[PCB_PER_SLAB];
+    struct pcb_cold_t colds[PCB_PER_SLAB];
+};
+
+static_assert(sizeof(struct PcbSlab) <= SLAB_SIZE, "a slab must fit SLAB_SIZE bytes");
+
+static struct PcbSlab *pcb_slabs = NULL;
+static usize pcb_slabs_no = 0;
 static struct list_head pcb_free;
 
+// free passup descriptors are linked through their first word
+union PassupNode {
+    struct passup_t passup;
+    union PassupNode *next;
+};
+
+static union PassupNode *passup_free = NULL;
+
+/**
+ * Returns the slab in which p has been carved.
+ */
+static struct PcbSlab *slabOf(const struct pcb_t *const p) {
+    struct PcbSlab *const slab = (struct PcbSlab *) ((memaddr) p & ~(SLAB_SIZE - 1U));
+    debug_assert(slab->index < pcb_slabs_no);
+    debug_assert(slab->pcbs <= p && p < &slab->pcbs[PCB_PER_SLAB]);
+    return slab;
+}
+
+/**
+ * Gives the passup descriptor of a pcb (if any) back to the pool.
+ */
+static void releasePassup(struct pcb_cold_t *const cold) {
+    debug_assert(NULL != cold);
+
+    if (NULL != cold->p_passup) {
+        union PassupNode *const node = container_of(cold->p_passup, union PassupNode, passup);
+        node->next = passup_free;
+        passup_free = node;
+        cold->p_passup = NULL;
+    }
+}
+
+static void freeSlab(struct PcbSlab *const slab) {
+    debug_assert(NULL != slab);
+
+    for (usize i = 0; i < PCB_PER_SLAB; ++i) {
+        releasePassup(&slab->colds[i]);
+        slab->pcbs[i].p_queue = PcbQueue_Free;
+        list_add_tail(&slab->pcbs[i].p_next, &pcb_free);
+    }
+}
+
+/**
+ * Carves a new slab of pcbs adding them to the free list.
+ * Returns false if there is no free RAM left.
+ */
+static bool growPcbs(void) {
+    // each pcb of the slab brings a new PID, thus a new stack frame.
+    struct PcbSlab *const slab = slab_carve(PCB_PER_SLAB);
+
+    if (NULL == slab) {
+        return false;
+    }
+
+    memclr(slab, sizeof(*slab));
+    slab->next = pcb_slabs;
+    slab->index = pcb_slabs_no;
+    pcb_slabs = slab;
+    pcb_slabs_no += 1;
+
+    freeSlab(slab);
+    return true;
+}
+
 void initPcbs(void) {
     INIT_LIST_HEAD(&pcb_free);
 
-    const struct pcb_t *const end = &pcb_table[MAX_PROC_NO];
-    for (struct pcb_t *cur = &pcb_table[0]; end > cur; ++cur) {
-        list_add(&cur->p_next, &pcb_free);
+    // slabs carved so far are reused, new ones are carved on demand.
+    for (struct PcbSlab *slab = pcb_slabs; NULL != slab; slab = slab->next) {
+        freeSlab(slab);
     }
 }
 
 void freePcb(struct pcb_t *const p) {
     debug_assert(NULL != p);
+    debug_assert(PcbQueue_None == p->p_queue || PcbQueue_Running == p->p_queue);
+    releasePassup(pcbCold(p));
+    p->p_queue = PcbQueue_Free;
     list_add_tail(&p->p_next, &pcb_free);
 }
 
 struct pcb_t *allocPcb(void) {
-    struct list_head *node = list_next(&pcb_free);
-
-    if (NULL != node) {
-        struct pcb_t *p = container_of(node, struct pcb_t, p_next);
-        list_del(node);
-        memclr(p, sizeof(*p));
-        INIT_LIST_HEAD(&p->p_next);
-        INIT_LIST_HEAD(&p->p_child);
-        INIT_LIST_HEAD(&p->p_sib);
-        return p;
+    if (list_empty(&pcb_free) && !growPcbs()) {
+        return NULL;
     }
 
-    return NULL;
+    struct list_head *node = list_next(&pcb_free);
+    assert(NULL != node);
+
+    struct pcb_t *p = container_of(node, struct pcb_t, p_next);
+    debug_assert(PcbQueue_Free == p->p_queue);
+    list_del(node);
+    // p_queue is PcbQueue_None from now on
+    memclr(p, sizeof(*p));
+    debug_assert(NULL == pcbCold(p)->p_passup);
+    INIT_LIST_HEAD(&p->p_next);
+    INIT_LIST_HEAD(&p->p_child);
+    INIT_LIST_HEAD(&p->p_sib);
+    return p;
 }
 
 void mkEmptyProcQ(struct list_head *const head) {
@@ -103,8 +194,8 @@ struct pcb_t *outProcQ(struct list_head *const head, struct pcb_t *const p) {
 
 int emptyChild(struct pcb_t *const root) {
     debug_assert(NULL != root);
-    struct list_head *const next = list_next(&root->p_child);
-    return NULL == next || root != container_of(next, struct pcb_t, p_child)->p_parent;
+    debug_assert(list_empty(&root->p_child) == (0 == root->p_childCount));
+    return list_empty(&root->p_child);
 }
 
 void insertChild(struct pcb_t *const root, struct pcb_t *const p) {
@@ -113,97 +204,122 @@ void insertChild(struct pcb_t *const root, struct pcb_t *const p) {
     debug_assert(NULL == p->p_parent);
 
     p->p_parent = root;
-    if (emptyChild(root)) {
-        list_add(&p->p_child, &root->p_child);
-    } else {
-        struct pcb_t *const child = container_of(list_next(&root->p_child), struct pcb_t, p_child);
-        assert(root == child->p_parent);
-        list_add_tail(&p->p_sib, &child->p_sib);
-    }
+    list_add_tail(&p->p_sib, &root->p_child);
+    root->p_childCount += 1;
 }
 
 struct pcb_t *removeChild(struct pcb_t *const root) {
     debug_assert(NULL != root);
+    struct pcb_t *const child = firstChild(root);
+    return (NULL == child) ? NULL : outChild(child);
+}
 
-    /**
-     * LEGEND:
-     *  Progeny: a circular list of p_child nodes.
-     *  Founder: the root node of a progeny.
-     */
-
-    if (!emptyChild(root)) {
-        struct pcb_t *const child = container_of(list_next(&root->p_child), struct pcb_t, p_child);
-        struct pcb_t *founder = root;
-
-        /**
-         * Looking for the founder.
-         *
-         * The founder must exist: it is either someone above
-         * the parent of the child or the parent of the child itself.
-         *
-         * The founder is the only node of its progeny that has the parent outside the progeny itself.
-         */
-        if (NULL != founder->p_parent) {
-            list_for_each_entry_reverse(founder, &root->p_child, p_child) {
-                if (NULL == founder->p_parent) {
-                    break;
-                }
-            }
-        }
+struct pcb_t *outChild(struct pcb_t *const child) {
+    debug_assert(NULL != child);
+    struct pcb_t *const parent = child->p_parent;
 
-        // hot potato: removing child's progeny sub-tree and update links accordingly.
-        assert(NULL != founder);
-        struct list_head *const last_child = list_prev(&founder->p_child);
-        assert(NULL != last_child);
-        struct list_head *const child_node = &child->p_child;
-        assert(NULL != child_node);
-        __list_del(&root->p_child, &founder->p_child);
-        last_child->next = child_node;
-        child_node->prev = last_child;
-        // hot potato
-
-        if (!list_empty(&child->p_sib)) {
-            struct pcb_t *const sib = container_of(list_next(&child->p_sib), struct pcb_t, p_sib);
-            list_del(&child->p_sib);
-            INIT_LIST_HEAD(&child->p_sib);
-            list_add(&sib->p_child, &root->p_child);
-        }
+    if (NULL == parent) {
+        return NULL;
+    }
+
+    debug_assert(0 < parent->p_childCount);
+    list_del(&child->p_sib);
+    INIT_LIST_HEAD(&child->p_sib);
+    parent->p_childCount -= 1;
+    child->p_parent = NULL;
+    return child;
+}
+
+struct pcb_t *firstChild(struct pcb_t *const root) {
+    debug_assert(NULL != root);
+    return emptyChild(root) ? NULL : container_of(list_next(&root->p_child), struct pcb_t, p_sib);
+}
 
-        child->p_parent = NULL;
-        return child;
+struct pcb_t *nextSibling(struct pcb_t *const p) {
+    debug_assert(NULL != p);
+
+    if (NULL == p->p_parent) {
+        return NULL;
     }
 
-    return NULL;
+    // the children list of the parent is the sentinel of the siblings
+    struct list_head *const next = p->p_sib.next;
+    return (&p->p_parent->p_child == next) ? NULL : container_of(next, struct pcb_t, p_sib);
 }
 
-struct pcb_t *outChild(struct pcb_t *const child) {
-    debug_assert(NULL != child);
+struct pcb_t *prevSibling(struct pcb_t *const p) {
+    debug_assert(NULL != p);
 
-    if (NULL == child->p_parent) {
+    if (NULL == p->p_parent) {
         return NULL;
     }
 
-    struct pcb_t *const parent = child->p_parent;
-    struct list_head *const prev = list_prev(&child->p_child);
-
-    if (prev == &parent->p_child) {
-        // child is the first child of the parent
-        return removeChild(parent);
-    } else {
-        /*
-           child is not the first child of the parent => child is a sib of the
-           first child of parent (sib list is not empty)
-         */
-        list_del(&child->p_sib);
-        INIT_LIST_HEAD(&child->p_sib);
-        child->p_parent = NULL;
-        return child;
+    struct list_head *const prev = p->p_sib.prev;
+    return (&p->p_parent->p_child == prev) ? NULL : container_of(prev, struct pcb_t, p_sib);
+}
+
+/**
+ * Returns the first process of the post-order traversal of the sub-tree rooted in node.
+ */
+static struct pcb_t *leftmostLeaf(struct pcb_t *node) {
+    for (struct pcb_t *child = firstChild(node); NULL != child; child = firstChild(node)) {
+        node = child;
+    }
+
+    return node;
+}
+
+struct pcb_t *firstPostOrder(struct pcb_t *const root) {
+    debug_assert(NULL != root);
+    return leftmostLeaf(root);
+}
+
+struct pcb_t *nextPostOrder(struct pcb_t *const root, struct pcb_t *const node) {
+    debug_assert(NULL != root);
+    debug_assert(NULL != node);
+
+    if (root == node) {
+        return NULL;
     }
+
+    // the sub-trees of the next siblings come first, then the parent.
+    struct pcb_t *const sib = nextSibling(node);
+    return (NULL == sib) ? node->p_parent : leftmostLeaf(sib);
 }
 
 usize getPid(const struct pcb_t *const p) {
     debug_assert(NULL != p);
-    debug_assert(pcb_table <= p);
-    debug_assert(p < &pcb_table[MAX_PROC_NO]);
-    return (p - pcb_table) + 1;
+    const struct PcbSlab *const slab = slabOf(p);
+    return slab->index * PCB_PER_SLAB + (usize) (p - slab->pcbs) + 1;
+}
+
+struct pcb_cold_t *pcbCold(const struct pcb_t *const p) {
+    debug_assert(NULL != p);
+    struct PcbSlab *const slab = slabOf(p);
+    return &slab->colds[p - slab->pcbs];
+}
+
+struct passup_t *allocPassup(struct pcb_t *const p) {
+    debug_assert(NULL != p);
+    struct pcb_cold_t *const cold = pcbCold(p);
+    assert(NULL == cold->p_passup);
+
+    if (NULL == passup_free) {
+        union PassupNode *const slab = slab_carve(0);
+
+        if (NULL == slab) {
+            return NULL;
+        }
+
+        for (usize i = 0; i < SLAB_SIZE / sizeof(union PassupNode); ++i) {
+            slab[i].next = passup_free;
+            passup_free = &slab[i];
+        }
+    }
+
+    union PassupNode *const node = passup_free;
+    passup_free = node->next;
+    memclr(&node->passup, sizeof(node->passup));
+    cold->p_passup = &node->passup;
+    return cold->p_passup;
 }
@@ -5,38 +5,35 @@
 
 // NOTE: keep this portion of code free of arch-specified code!
 
-// High level states of a printer device.
-enum PrinterStatus {
-    PRINTER_STATUS_ERR,
-    PRINTER_STATUS_BUSY,
-    PRINTER_STATUS_READY,
-    PRINTER_STATUS_ABSENT,
-};
-
-static enum PrinterStatus transmit(unsigned handle, char character);
+static usize transmit(unsigned handle, const char *buf, usize len);
 
 bool printer_putchar(const unsigned handle, const char character) {
     debug_assert(handle < MACHINE_DEVICE_PRINTER_NO);
-
-    switch(transmit(handle, character)) {
-        case PRINTER_STATUS_READY:
-            return true;
-
-        default:
-            return false;
-    }
+    return 1 == transmit(handle, &character, 1);
 }
 
 usize printer_puts(const unsigned handle, const char *str) {
-    usize i = 0;
+    debug_assert(handle < MACHINE_DEVICE_PRINTER_NO);
+    usize len = 0;
 
     if (NULL != str) {
-        while (*str && printer_putchar(handle, *(str++))) {
-            ++i;
+        while (str[len]) {
+            ++len;
         }
     }
 
-    return i;
+    return transmit(handle, str, len);
+}
+
+int printer_spool(const char *const buf, const usize len, int *const semaphore) {
+    int printer = 0;
+
+    // SPOOL returns 0 when it had to wait for a printer to free up, hence it is retried.
+    while (0 == printer) {
+        printer = SYSCALL(SPOOL, (memaddr) buf, (memaddr) len, (memaddr) semaphore);
+    }
+
+    return (0 > printer) ? -1 : printer - 1;
 }
 
 /**
@@ -60,39 +57,20 @@ usize printer_puts(const unsigned handle, const char *str) {
 #error "Unknown target architecture"
 #endif
 
-#define RAW_STATUS_ERR       4U
-#define RAW_STATUS_BUSY      3U
-#define RAW_STATUS_READY     1U
-#define RAW_STATUS_ABSENT    0U
-
-#define CMD_ACK              1U
-#define CMD_PRINT            2U
-
-static enum PrinterStatus decodeStatus(unsigned rawStatus);
-
-static enum PrinterStatus transmit(const unsigned handle, const char character) {
+static usize transmit(const unsigned handle, const char *buf, usize len) {
     debug_assert(handle < MACHINE_DEVICE_PRINTER_NO);
-    dtpreg_t *const printerRegister = (dtpreg_t *) DEV_REG_ADDR(INTERRUPT_LINE_PRINTER, handle);
-
-    printerRegister->data0 = character;
-    return decodeStatus((unsigned) SYSCALL(WAITIO, CMD_PRINT, (memaddr) printerRegister, 0));
-}
-
-static enum PrinterStatus decodeStatus(const unsigned rawStatus) {
-    switch(rawStatus) {
-        case RAW_STATUS_ERR:
-            return PRINTER_STATUS_ERR;
-
-        case RAW_STATUS_BUSY:
-            return PRINTER_STATUS_BUSY;
+    usize i = 0;
 
-        case RAW_STATUS_READY:
-            return PRINTER_STATUS_READY;
+    // WRITE queues as many characters as there is room for, blocking only if the queue is full.
+    while (i < len) {
+        const int n = SYSCALL(WRITE, DEV_REG_ADDR(INTERRUPT_LINE_PRINTER, handle), (memaddr) (buf + i), len - i);
 
-        case RAW_STATUS_ABSENT:
-            return PRINTER_STATUS_ABSENT;
+        if (0 > n) {
+            break;
+        }
 
-        default:
-            unreachable();
+        i += (usize) n;
     }
+
+    return i;
 }
@@ -0,0 +1,145 @@
+#include <primitive_types.h>
+#include <assertions.h>
+#include <helpers.h>
+#include <listx.h>
+#include <pcb.h>
+#include <readyq.h>
+
+#define TOP_LEVEL       (READYQ_LEVELS - 1)
+#define SLOT_MASK       (READYQ_LEVELS - 1U)
+#define SLOT_BIT(s)     (1U << (s))
+
+static_assert(32 == READYQ_LEVELS, "the bitmap of the ready queue is a single u32");
+
+static unsigned levelOf(const int priority) {
+    return (0 > priority) ? 0U : (TOP_LEVEL < priority) ? TOP_LEVEL : (unsigned) priority;
+}
+
+/**
+ * Returns the index of the bucket that holds the given level at the current epoch.
+ */
+static unsigned slotOf(const struct readyq_t *const q, const unsigned level) {
+    return (level - q->epoch) & SLOT_MASK;
+}
+
+/**
+ * Returns the index of the bucket that holds the highest non-empty level.
+ */
+static unsigned topSlot(const struct readyq_t *const q) {
+    debug_assert(0 != q->bitmap);
+    const unsigned shift = q->epoch & SLOT_MASK;
+
+    // rotating the bitmap by the epoch gives back the bitmap indexed by level
+    const u32 levels = (0 == shift) ? q->bitmap
+                                    : (q->bitmap << shift) | (q->bitmap >> (READYQ_LEVELS - shift));
+    return slotOf(q, TOP_LEVEL - u32_clz(levels));
+}
+
+int agePriority(const int priority, const u32 elapsed) {
+    if (TOP_LEVEL <= priority) {
+        return priority;
+    }
+
+    return (elapsed >= (u32) (TOP_LEVEL - priority)) ? TOP_LEVEL : priority + (int) elapsed;
+}
+
+void mkEmptyReadyQ(struct readyq_t *const q) {
+    debug_assert(NULL != q);
+    q->epoch = 0;
+    q->bitmap = 0;
+
+    for (unsigned i = 0; i < READYQ_LEVELS; ++i) {
+        INIT_LIST_HEAD(&q->buckets[i]);
+    }
+}
+
+int emptyReadyQ(const struct readyq_t *const q) {
+    debug_assert(NULL != q);
+    return 0 == q->bitmap;
+}
+
+void insertReadyQ(struct readyq_t *const q, struct pcb_t *const p) {
+    debug_assert(NULL != q);
+    debug_assert(NULL != p);
+    debug_assert(PcbQueue_None == p->p_queue || PcbQueue_Running == p->p_queue);
+    const unsigned slot = slotOf(q, levelOf(p->priority));
+
+    p->p_queue = PcbQueue_Ready;
+    p->enqueue_epoch = q->epoch;
+    list_add_tail(&p->p_next, &q->buckets[slot]);
+    q->bitmap |= SLOT_BIT(slot);
+}
+
+struct pcb_t *headReadyQ(const struct readyq_t *const q) {
+    debug_assert(NULL != q);
+    return emptyReadyQ(q) ? NULL
+                          : container_of(q->buckets[topSlot(q)].next, struct pcb_t, p_next);
+}
+
+struct pcb_t *removeReadyQ(struct readyq_t *const q) {
+    debug_assert(NULL != q);
+
+    if (emptyReadyQ(q)) {
+        return NULL;
+    }
+
+    const unsigned slot = topSlot(q);
+    struct list_head *const bucket = &q->buckets[slot];
+    struct pcb_t *const proc = container_of(bucket->next, struct pcb_t, p_next);
+    debug_assert(PcbQueue_Ready == proc->p_queue);
+
+    proc->p_queue = PcbQueue_None;
+    list_del(&proc->p_next);
+    INIT_LIST_HEAD(&proc->p_next);
+    if (list_empty(bucket)) {
+        q->bitmap &= ~SLOT_BIT(slot);
+    }
+
+    proc->priority = agePriority(proc->priority, q->epoch - proc->enqueue_epoch);
+    return proc;
+}
+
+struct pcb_t *outReadyQ(struct readyq_t *const q, struct pcb_t *const p) {
+    debug_assert(NULL != q);
+    debug_assert(NULL != p);
+    debug_assert(PcbQueue_Ready == p->p_queue);
+    debug_assert(!list_empty(&p->p_next));
+    struct list_head *const next = p->p_next.next;
+
+    p->p_queue = PcbQueue_None;
+    list_del(&p->p_next);
+    INIT_LIST_HEAD(&p->p_next);
+
+    // if p was the last entry of its bucket, next is now an empty bucket of q.
+    if (list_empty(next) && &q->buckets[0] <= next && next < &q->buckets[READYQ_LEVELS]) {
+        q->bitmap &= ~SLOT_BIT(next - q->buckets);
+    }
+
+    return p;
+}
+
+void ageReadyQ(struct readyq_t *const q) {
+    debug_assert(NULL != q);
+    const unsigned top = slotOf(q, TOP_LEVEL);
+    const unsigned below = slotOf(q, TOP_LEVEL - 1);
+
+    // Once the epoch is advanced the top bucket would wrap to level 0:
+    // processes already at the top level can't go any higher, so they are
+    // moved ahead of the ones that are reaching the top level from below.
+    if (!list_empty(&q->buckets[top])) {
+        struct list_head *const from = &q->buckets[top];
+        struct list_head *const to = &q->buckets[below];
+        struct list_head *const first = from->next;
+        struct list_head *const last = from->prev;
+
+        last->next = to->next;
+        to->next->prev = last;
+        first->prev = to;
+        to->next = first;
+        INIT_LIST_HEAD(from);
+
+        q->bitmap = (q->bitmap & ~SLOT_BIT(top)) | SLOT_BIT(below);
+    }
+
+    q->epoch += 1;
+}
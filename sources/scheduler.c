@@ -1,22 +1,252 @@
 #include <pcb.h>
 #include <asl.h>
+#include <readyq.h>
+#include <sleepq.h>
 #include <core.h>
 #include <memory.h>
+#include <kinfo.h>
 #include <assertions.h>
 #include <scheduler.h>
 
-struct list_head readyQueue = LIST_HEAD_INIT(readyQueue);
+struct readyq_t readyQueue;
+struct sleepq_t sleepQueue;
 struct pcb_t *curProc = NULL;
-static int globalAge = 0;
+
+// I/O channel: a device (or a terminal receiver) and the processes waiting for it.
+struct IOChannel {
+    int semaphore;          // key on which the processes waiting for the channel are blocked
+    bool busy;              // true while a command is in flight
+    struct pcb_t *owner;    // process that issued the command in flight (NULL if it has been dropped)
+};
+
+static struct IOChannel ioChannels[IO_CHANNEL_NO];
+
+// number of processes blocked on a semaphore (I/O channels included) or sleeping
+static unsigned blockedCount = 0;
+
+// idle time accounting: total ticks spent waiting and TOD at which the processor went idle
+static usize idleTime = 0;
+static ticks64_t idleSince = 0;
+static bool idling = false;
+
+// false while the current process is the only runnable one and runs without time slice
+static bool sliceArmed = false;
+
+// TOD at which the time slice of the current process ends, if armed
+static ticks_t sliceEnd = 0;
+
+// true if a process that outranks the current one has become ready since it was dispatched
+static bool preemptCurProc = false;
+
+// Process that left the processor whose latest state is still in the old area
+// filled by the BIOS (or in the state of the custom handler it was passed up to),
+// rather than in its PCB: the state is copied only when another process is
+// dispatched (see flushLazyState), so a process that is dispatched again right
+// away is resumed straight from there.
+static struct pcb_t *lazyProc = NULL;
+static cpustate_t *lazyState = NULL;
 
 static void dropProcess(struct pcb_t *proc);
-static void dropProgeny(struct pcb_t *node);
+
+void scheduler_init(void) {
+    mkEmptyReadyQ(&readyQueue);
+    mkEmptySleepQ(&sleepQueue, machine_getTODLow());
+    curProc = NULL;
+    memclr(ioChannels, sizeof(ioChannels));
+    blockedCount = 0;
+    idleTime = 0;
+    idling = false;
+    lazyProc = NULL;
+    lazyState = NULL;
+}
+
+/**
+ * Returns the authoritative state of a process that is not running.
+ */
+static cpustate_t *stateOf(struct pcb_t *const proc) {
+    debug_assert(NULL != proc);
+    return (lazyProc == proc) ? lazyState : &pcbCold(proc)->p_s;
+}
+
+/**
+ * Copies the state of the process that left the processor into its PCB,
+ * before the old area that holds it may be overwritten.
+ */
+static void flushLazyState(void) {
+    if (NULL != lazyProc) {
+        memdup(&pcbCold(lazyProc)->p_s, lazyState, sizeof(*lazyState));
+        lazyProc = NULL;
+        lazyState = NULL;
+    }
+}
+
+/**
+ * Takes the current process off the processor: its state stays where the BIOS
+ * saved it until another process is dispatched.
+ */
+static void suspendCurProc(cpustate_t *const procState) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != procState);
+    debug_assert(NULL == lazyProc);
+
+    lazyProc = curProc;
+    lazyState = procState;
+    curProc = NULL;
+}
 
 static inline void updateCurProcTime(const ticks_t timeLeft, const ticks_t handlerTime) {
     debug_assert(NULL != curProc);
     curProc->user_time += curProc->latest_handler_time - timeLeft;
     curProc->kernel_time += handlerTime;
-    curProc->latest_handler_time = (handlerTime > timeLeft) ? 0 : timeLeft - handlerTime;
+}
+
+/**
+ * Returns the ticks from now to the next event the interval timer has to raise:
+ * the end of the time slice (if armed and requested) or the next event of the
+ * sleep queue, whichever comes first.
+ */
+static ticks_t ticksToNextEvent(const bool slice) {
+    const ticks_t now = machine_getTODLow();
+    ticks_t ticks = INTERVAL_TIMER_MAX;
+
+    if (slice && sliceArmed) {
+        ticks = (0 < (i32) (sliceEnd - now)) ? sliceEnd - now : 0;
+    }
+
+    if (!emptySleepQ(&sleepQueue)) {
+        const ticks_t next = nextEventSleepQ(&sleepQueue);
+        const ticks_t untilNext = (0 < (i32) (next - now)) ? next - now : 0;
+        ticks = (untilNext < ticks) ? untilNext : ticks;
+    }
+
+    return ticks;
+}
+
+/**
+ * Programs the interval timer before resuming the current process.
+ * If another process became ready while the current one was running alone
+ * (tickless), a full time slice is armed from now on.
+ */
+static void setCurProcTimer(void) {
+    debug_assert(NULL != curProc);
+
+    if (!sliceArmed && !emptyReadyQ(&readyQueue)) {
+        sliceArmed = true;
+        sliceEnd = machine_getTODLow() + TIME_SLICE * machine_getClockResolution();
+    }
+
+    curProc->latest_handler_time = ticksToNextEvent(true);
+    machine_setIntervalTimer(curProc->latest_handler_time);
+}
+
+/**
+ * Loads a state on behalf of the current process, publishing its identity and
+ * times on the kernel info page beforehand.
+ */
+static void loadCurProc(cpustate_t *const state) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != state);
+
+    kinfo_publish(curProc, curProc->p_parent, curProc->user_time, curProc->kernel_time,
+                  curProc->start_time, curProc->latest_handler_time);
+    core_loadState(state);
+}
+
+/**
+ * Returns the I/O channel whose semaphore is key, NULL if key is not the semaphore of a channel.
+ */
+static struct IOChannel *ioChannelOf(int *const key) {
+    if ((int *) &ioChannels[0] <= key && key < (int *) &ioChannels[IO_CHANNEL_NO]) {
+        return container_of(key, struct IOChannel, semaphore);
+    }
+
+    return NULL;
+}
+
+/**
+ * Inserts proc in the ready queue and requests the preemption of the current
+ * process if proc has a higher priority; the switch takes place as soon as the
+ * current process is about to be resumed (see scheduler_resume).
+ */
+static void makeReady(struct pcb_t *const proc) {
+    debug_assert(NULL != proc);
+    insertReadyQ(&readyQueue, proc);
+
+    if (NULL != curProc && proc->priority > curProc->priority) {
+        preemptCurProc = true;
+    }
+}
+
+/**
+ * Makes ready a process which has been removed from the queue of a semaphore.
+ */
+static void wakeUp(struct pcb_t *const proc) {
+    debug_assert(NULL != proc);
+    blockedCount -= 1;
+    // blocked processes keep aging.
+    proc->priority = agePriority(proc->priority, readyQueue.epoch - proc->enqueue_epoch);
+    makeReady(proc);
+}
+
+/**
+ * Puts the current process back in the ready queue and dispatches the next one.
+ * Time accounting must have already been done by the caller.
+ */
+static noreturn void yieldCurProc(cpustate_t *const procState) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != procState);
+
+    curProc->priority = curProc->original_priority;
+    insertReadyQ(&readyQueue, curProc);
+    suspendCurProc(procState);
+    scheduler_dispatch();
+    unreachable();
+}
+
+/**
+ * Makes ready the sleeping processes whose wakeup is due by now.
+ */
+static void wakeSleepers(const ticks_t now) {
+    for (struct pcb_t *proc = removeSleepQ(&sleepQueue, now); NULL != proc; proc = removeSleepQ(&sleepQueue, now)) {
+        wakeUp(proc);
+    }
+}
+
+/**
+ * Loads the given state on behalf of the current process, unless a process that outranks
+ * it has become ready: then the current process is put back in the ready queue with
+ * that state, so that it starts from there once it is dispatched again.
+ * Time accounting must have already been done by the caller.
+ */
+static void resumeCurProc(cpustate_t *const state) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != state);
+
+    if (preemptCurProc) {
+        yieldCurProc(state);
+    }
+
+    setCurProcTimer();
+    loadCurProc(state);
+}
+
+/**
+ * Blocks the current process on the semaphore identified by key and dispatches another process.
+ */
+static noreturn void blockCurProc(int *const key, cpustate_t *const procState, const ticks_t timeLeft, const ticks_t handlerTime) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != procState);
+
+    updateCurProcTime(timeLeft, handlerTime);
+    curProc->enqueue_epoch = readyQueue.epoch;
+
+    if (0 == insertBlocked(key, curProc)) {
+        blockedCount += 1;
+        suspendCurProc(procState);
+        scheduler_dispatch();
+    }
+
+    unreachable();
 }
 
 int scheduler_scheduleChild(const cpustate_t *const childState, const int priority, const void **const childPid) {
@@ -28,10 +258,10 @@ int scheduler_scheduleChild(const cpustate_t *const childState, const int priori
        return -1;
     }
 
-    memdup(&childProc->p_s, childState, sizeof(childProc->p_s));
+    memdup(&pcbCold(childProc)->p_s, childState, sizeof(*childState));
     childProc->priority = childProc->original_priority = priority;
     insertChild(curProc, childProc);
-    insertProcQ(&readyQueue, childProc);
+    makeReady(childProc);
 
     if (NULL != childPid) {
        *childPid = childProc;
@@ -45,8 +275,9 @@ bool scheduler_scheduleWith(void (*const process)(void), const int priority, con
     struct pcb_t *proc = allocPcb();
 
     if (NULL != proc) {
-        cpustate_t *state = &proc->p_s;
+        cpustate_t *state = &pcbCold(proc)->p_s;
 
+        memclr(state, sizeof(*state));
         state_update(state, (struct StateConfig) {
             .mode=CPU_MODE_KERNEL,
             .fastInterruptsEnabled=true,
@@ -55,7 +286,7 @@ bool scheduler_scheduleWith(void (*const process)(void), const int priority, con
         *state_programCounter(state) = (memaddr) process;
         state_setStackPointer(state, MACHINE_RAM_LIMIT - (MACHINE_STACK_SIZE * getPid(proc)));
         proc->priority = proc->original_priority = priority;
-        insertProcQ(&readyQueue, proc);
+        makeReady(proc);
 
         return true;
     }
@@ -63,43 +294,125 @@ bool scheduler_scheduleWith(void (*const process)(void), const int priority, con
     return false;
 }
 
+static void reportCurProcTime(struct TimeInfo *const timeInfo) {
+    debug_assert(NULL != curProc);
+
+    if (NULL != timeInfo) {
+        const ticks64_t wallclockTime = machine_getTOD64() - curProc->start_time;
+
+        if (NULL != timeInfo->userTime) *timeInfo->userTime = (ticks_t) curProc->user_time;
+        if (NULL != timeInfo->kernelTime) *timeInfo->kernelTime = (ticks_t) curProc->kernel_time;
+        if (NULL != timeInfo->wallclockTime) *timeInfo->wallclockTime = (ticks_t) wallclockTime;
+        if (NULL != timeInfo->userTime64) *timeInfo->userTime64 = curProc->user_time;
+        if (NULL != timeInfo->kernelTime64) *timeInfo->kernelTime64 = curProc->kernel_time;
+        if (NULL != timeInfo->wallclockTime64) *timeInfo->wallclockTime64 = wallclockTime;
+    }
+}
+
 void scheduler_resume(cpustate_t *const procState, const ticks_t timeLeft, const ticks_t handlerTime, struct TimeInfo *const timeInfo) {
     debug_assert(NULL != curProc);
     debug_assert(NULL != procState);
 
     updateCurProcTime(timeLeft, handlerTime);
-    if (NULL != timeInfo) {
-        if (NULL != timeInfo->userTime) *timeInfo->userTime = curProc->user_time;
-        if (NULL != timeInfo->kernelTime) *timeInfo->kernelTime = curProc->kernel_time;
-        if (NULL != timeInfo->wallclockTime) *timeInfo->wallclockTime = machine_getTODLow() - curProc->start_time;
+    reportCurProcTime(timeInfo);
+    resumeCurProc(procState);
+}
+
+bool scheduler_canResumeFast(void) {
+    // nothing outranks the current process and no time slice has to be armed (see setCurProcTimer).
+    return NULL != curProc && !preemptCurProc && (sliceArmed || emptyReadyQ(&readyQueue));
+}
+
+void scheduler_resumeFast(cpustate_t *const procState, const ticks_t timeLeft, struct TimeInfo *const timeInfo) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != procState);
+    debug_assert(scheduler_canResumeFast());
+    const ticks_t now = machine_getIntervalTimer();
+
+    // the timer expired during the handler: take the regular path to reprogram it.
+    if (now > timeLeft) {
+        scheduler_resume(procState, timeLeft, timeLeft - now, timeInfo);
+    } else {
+        // the slice kept running during the handler, which is charged as kernel time.
+        curProc->user_time += curProc->latest_handler_time - timeLeft;
+        curProc->kernel_time += timeLeft - now;
+        curProc->latest_handler_time = now;
+
+        reportCurProcTime(timeInfo);
+        loadCurProc(procState);
+    }
+}
+
+/**
+ * Waits for an interrupt if some process is blocked, since it may be woken up later on,
+ * otherwise there is nothing left to do and the machine is halted.
+ * The interval timer is armed only if some process is sleeping.
+ */
+static noreturn void idle(void) {
+    debug_assert(NULL == curProc);
+
+    if (0 == blockedCount) {
+        core_halt();
     }
 
-    machine_setIntervalTimer(curProc->latest_handler_time * machine_getClockResolution());
-    core_loadState(procState);
+    if (!idling) {
+        idling = true;
+        idleSince = machine_getTOD64();
+    }
+
+    // the interrupt that ends the wait overwrites its old area
+    if (MACHINE_OLD_INTERRUPT_AREA == lazyState) {
+        flushLazyState();
+    }
+
+    machine_setIntervalTimer(ticksToNextEvent(false));
+    core_idle();
 }
 
 void scheduler_dispatch(void) {
     debug_assert(NULL == curProc);
-    curProc = removeProcQ(&readyQueue);
+    curProc = removeReadyQ(&readyQueue);
 
     if (NULL == curProc) {
-        core_halt();
-        unreachable();
+        idle();
     }
 
-    struct pcb_t *iter = NULL;
-    list_for_each_entry(iter, &readyQueue, p_next) {
-        iter->priority += 1;
+    curProc->p_queue = PcbQueue_Running;
+
+    if (idling) {
+        idleTime += machine_getTOD64() - idleSince;
+        idling = false;
     }
-    globalAge += 1;
 
-    if (0 == curProc->start_time) {
-        curProc->start_time = machine_getTODLow();
+    ageReadyQ(&readyQueue);
+    preemptCurProc = false;
+
+    if (!curProc->started) {
+        curProc->started = true;
+        curProc->start_time = machine_getTOD64();
+    }
+
+    // A process that runs alone is not preempted until another one becomes ready:
+    // in the meantime no time slice is armed (see setCurProcTimer).
+    sliceArmed = !emptyReadyQ(&readyQueue);
+    sliceEnd = machine_getTODLow() + TIME_SLICE * machine_getClockResolution();
+    curProc->latest_handler_time = ticksToNextEvent(true);
+
+    machine_setIntervalTimer(curProc->latest_handler_time);
+
+    cpustate_t *state = NULL;
+
+    if (lazyProc == curProc) {
+        // the process has not been replaced by anybody else: no need to copy its state back and forth.
+        state = lazyState;
+        lazyProc = NULL;
+        lazyState = NULL;
+    } else {
+        flushLazyState();
+        state = &pcbCold(curProc)->p_s;
     }
-    curProc->latest_handler_time = TIME_SLICE;
 
-    machine_setIntervalTimer(TIME_SLICE * machine_getClockResolution());
-    core_loadState(&curProc->p_s);
+    loadCurProc(state);
 }
 
 void scheduler_contextSwitch(cpustate_t *const procState, const ticks_t timeLeft, const ticks_t handlerTime) {
@@ -107,86 +420,91 @@ void scheduler_contextSwitch(cpustate_t *const procState, const ticks_t timeLeft
     debug_assert(NULL != procState);
 
     updateCurProcTime(timeLeft, handlerTime);
-    curProc->priority = curProc->original_priority;
-    memdup(&curProc->p_s, procState, sizeof(*procState));
-
-    insertProcQ(&readyQueue, curProc);
-    curProc = NULL;
-    scheduler_dispatch();
-    unreachable();
+    yieldCurProc(procState);
 }
 
 static void dropProcess(struct pcb_t *const proc) {
     debug_assert(NULL != proc);
 
-    // proc must be in the ready queue or in the blocked queue of a semaphore
-    if (NULL == outProcQ(&readyQueue, proc) && NULL == outBlocked(proc)) {
-        unreachable();
-    }
+    switch (proc->p_queue) {
+        case PcbQueue_Blocked: {
+            debug_assert(NULL != proc->p_semkey);
+            struct IOChannel *const channel = ioChannelOf(proc->p_semkey);
 
-    freePcb(proc);
-}
+            if (NULL != channel) {
+                // the command in flight (if any) is completed anyway, but nobody will be woken up
+                channel->owner = (channel->owner == proc) ? NULL : channel->owner;
+            }
 
-static void dropProgeny(struct pcb_t *const node) {
-    debug_assert(NULL != node);
-    struct pcb_t *child = NULL;
-    struct pcb_t *tmpChild = NULL;
+            blockedCount -= 1;
+            outBlocked(proc);
+            break;
+        }
 
-    list_for_each_entry_reverse(child, &node->p_child, p_child) {
-        struct pcb_t *sib = NULL;
-        struct pcb_t *tmpSib = NULL;
+        case PcbQueue_Ready:
+            outReadyQ(&readyQueue, proc);
+            break;
 
-        if (NULL != tmpChild) {
-            dropProcess(tmpChild);
-            tmpChild = NULL;
-        }
+        case PcbQueue_Sleeping:
+            blockedCount -= 1;
+            outSleepQ(&sleepQueue, proc);
+            break;
 
-        list_for_each_entry_reverse(sib, &child->p_sib, p_sib) {
-            if (NULL != tmpSib) {
-                dropProcess(tmpSib);
-                tmpSib = NULL;
-            }
+        case PcbQueue_Running:
+            debug_assert(curProc == proc);
+            break;
 
-            dropProgeny(sib);
-            tmpSib = sib;
-        }
+        default:
+            unreachable();
+    }
+
+    // a state is left in an old area only while the processor is idle
+    debug_assert(lazyProc != proc);
+    freePcb(proc);
+}
+
+/**
+ * Returns true if node belongs to the sub-tree rooted in root (root included).
+ */
+static bool isInSubtree(const struct pcb_t *const root, const struct pcb_t *node) {
+    debug_assert(NULL != root);
 
-        tmpChild = child;
-        if (NULL != tmpSib) {
-            dropProcess(tmpSib);
-            tmpSib = NULL;
+    for (; NULL != node; node = node->p_parent) {
+        if (root == node) {
+            return true;
         }
     }
 
-    if (NULL != tmpChild) {
-        dropProcess(tmpChild);
-        tmpChild = NULL;
-    }
+    return false;
 }
 
-void scheduler_drop(void *const pid, cpustate_t *const procState) {
+void scheduler_drop(void *const pid) {
     debug_assert(NULL != curProc);
-    debug_assert(NULL != procState);
-    
+
     struct pcb_t *const proc = (NULL == pid) ? curProc : pid;
     debug_assert(NULL != proc);
-    
-    // Suspend current process
-    memdup(&curProc->p_s, procState, sizeof(curProc->p_s));
-    curProc->priority = MACHINE_MAX_INT;
-    insertProcQ(&readyQueue, curProc);
+
+    // the state of the current process is left in the old area: either it is resumed from there or it is dropped.
+    const bool dropsCurProc = isInSubtree(proc, curProc);
 
     outChild(proc);
-    dropProgeny(proc);
-    dropProcess(proc);
 
-    if (headProcQ(&readyQueue) != curProc) {
+    // children are dropped before their parent, proc is dropped last.
+    struct pcb_t *next = NULL;
+    for (struct pcb_t *node = firstPostOrder(proc); NULL != node; node = next) {
+        next = nextPostOrder(proc, node);
+        dropProcess(node);
+    }
+
+    if (dropsCurProc) {
         curProc = NULL;
         scheduler_dispatch();
         unreachable();
     }
+}
 
-    removeProcQ(&readyQueue);
+usize scheduler_getIdleTime(void) {
+    return idleTime;
 }
 
 const void *scheduler_getCurrentProcess(void) {
@@ -202,23 +520,28 @@ int scheduler_registerCustomHandler(const enum ExcType type, cpustate_t *const o
     debug_assert(NULL != oldArea);
     debug_assert(NULL != handler);
 
+    struct passup_t *passup = pcbCold(curProc)->p_passup;
     cpustate_t **oldAreaRef;
     cpustate_t **handlerRef;
 
+    if (NULL == passup && NULL == (passup = allocPassup(curProc))) {
+        return -1;
+    }
+
     switch (type) {
         case ExcType_Sysbk:
-            oldAreaRef = &curProc->sysbkOldArea;
-            handlerRef = &curProc->sysbkHandler;
+            oldAreaRef = &passup->sysbkOldArea;
+            handlerRef = &passup->sysbkHandler;
             break;
 
         case ExcType_TLB:
-            oldAreaRef = &curProc->TLBOldArea;
-            handlerRef = &curProc->TLBHandler;
+            oldAreaRef = &passup->TLBOldArea;
+            handlerRef = &passup->TLBHandler;
             break;
 
         case ExcType_Trap:
-            oldAreaRef = &curProc->trapOldArea;
-            handlerRef = &curProc->trapHandler;
+            oldAreaRef = &passup->trapOldArea;
+            handlerRef = &passup->trapHandler;
             break;
 
         default: 
@@ -240,16 +563,17 @@ void scheduler_callSysbkHandler(cpustate_t *const procState, const ticks_t timeL
     debug_assert(NULL != curProc);
     debug_assert(NULL != procState);
 
-    if (NULL != curProc->sysbkHandler) {
-        debug_assert(NULL != curProc->sysbkOldArea);
+    const struct passup_t *const passup = pcbCold(curProc)->p_passup;
+
+    if (NULL != passup && NULL != passup->sysbkHandler) {
+        debug_assert(NULL != passup->sysbkOldArea);
 
         updateCurProcTime(timeLeft, handlerTime);
-        memdup(curProc->sysbkOldArea, procState, sizeof(*procState));
-        machine_setIntervalTimer(curProc->latest_handler_time * machine_getClockResolution());
-        core_loadState(curProc->sysbkHandler);
+        memdup(passup->sysbkOldArea, procState, sizeof(*procState));
+        resumeCurProc(passup->sysbkHandler);
     }
 
-    scheduler_drop(NULL, procState);
+    scheduler_drop(NULL);
     unreachable();
 }
 
@@ -257,16 +581,17 @@ void scheduler_callTLBHandler(cpustate_t *const procState, const ticks_t timeLef
     debug_assert(NULL != curProc);
     debug_assert(NULL != procState);
 
-    if (NULL != curProc->TLBHandler) {
-        debug_assert(NULL != curProc->TLBOldArea);
+    const struct passup_t *const passup = pcbCold(curProc)->p_passup;
+
+    if (NULL != passup && NULL != passup->TLBHandler) {
+        debug_assert(NULL != passup->TLBOldArea);
 
         updateCurProcTime(timeLeft, handlerTime);
-        memdup(curProc->TLBOldArea, procState, sizeof(*procState));
-        machine_setIntervalTimer(curProc->latest_handler_time * machine_getClockResolution());
-        core_loadState(curProc->TLBHandler);
+        memdup(passup->TLBOldArea, procState, sizeof(*procState));
+        resumeCurProc(passup->TLBHandler);
     }
 
-    scheduler_drop(NULL, procState);
+    scheduler_drop(NULL);
     unreachable();
 }
 
@@ -274,16 +599,17 @@ void scheduler_callTrapHandler(cpustate_t *const procState, const ticks_t timeLe
     debug_assert(NULL != curProc);
     debug_assert(NULL != procState);
 
-    if (NULL != curProc->trapHandler) {
-        debug_assert(NULL != curProc->trapOldArea);
+    const struct passup_t *const passup = pcbCold(curProc)->p_passup;
+
+    if (NULL != passup && NULL != passup->trapHandler) {
+        debug_assert(NULL != passup->trapOldArea);
 
         updateCurProcTime(timeLeft, handlerTime);
-        memdup(curProc->trapOldArea, procState, sizeof(*procState));
-        machine_setIntervalTimer(curProc->latest_handler_time * machine_getClockResolution());
-        core_loadState(curProc->trapHandler);
+        memdup(passup->trapOldArea, procState, sizeof(*procState));
+        resumeCurProc(passup->trapHandler);
     }
 
-    scheduler_drop(NULL, procState);
+    scheduler_drop(NULL);
     unreachable();
 }
 
@@ -294,29 +620,114 @@ void scheduler_passeren(int *const semaphoreKey, cpustate_t *const procState, co
     if (0 < *semaphoreKey) {
         *semaphoreKey -= 1;
     } else {
-        updateCurProcTime(timeLeft, handlerTime);
-        curProc->latest_handler_time = TIME_SLICE;
-        curProc->priority = globalAge - curProc->priority;
-        memdup(&curProc->p_s, procState, sizeof(curProc->p_s));
-
-        if (0 == insertBlocked(semaphoreKey, curProc)) {
-            curProc = NULL;
-            scheduler_dispatch();
-        }
-        
-        unreachable();
+        blockCurProc(semaphoreKey, procState, timeLeft, handlerTime);
     }
 }
 
+void scheduler_sleep(const ticks_t ticks, cpustate_t *const procState, const ticks_t timeLeft, const ticks_t handlerTime) {
+    debug_assert(NULL != curProc);
+    debug_assert(NULL != procState);
+    debug_assert(0 < ticks && ticks <= SLEEPQ_MAX_DELAY);
+    const ticks_t now = machine_getTODLow();
+
+    updateCurProcTime(timeLeft, handlerTime);
+    curProc->enqueue_epoch = readyQueue.epoch;
+
+    // the wheel is brought up to now, so that the delay is measured from there.
+    wakeSleepers(now);
+    insertSleepQ(&sleepQueue, curProc, now + ticks);
+
+    blockedCount += 1;
+    suspendCurProc(procState);
+    scheduler_dispatch();
+    unreachable();
+}
+
+void scheduler_wakeSleepers(void) {
+    wakeSleepers(machine_getTODLow());
+}
+
+bool scheduler_sliceExpired(void) {
+    return NULL != curProc && sliceArmed && 0 <= (i32) (machine_getTODLow() - sliceEnd);
+}
+
 void scheduler_verhogen(int *const semaphoreKey) {
     debug_assert(NULL != semaphoreKey);
-    debug_assert(NULL != curProc);
 
     struct pcb_t *const firstProc = removeBlocked(semaphoreKey);
     if (NULL == firstProc) {
         *semaphoreKey += 1;
     } else {
-        firstProc->priority = globalAge - firstProc->priority;
-        insertProcQ(&readyQueue, firstProc);
+        wakeUp(firstProc);
+    }
+}
+
+void scheduler_wakeAll(int *const semaphoreKey) {
+    debug_assert(NULL != semaphoreKey);
+
+    for (struct pcb_t *proc = removeBlocked(semaphoreKey); NULL != proc; proc = removeBlocked(semaphoreKey)) {
+        wakeUp(proc);
     }
 }
+
+bool scheduler_startIO(const unsigned channel) {
+    debug_assert(IO_CHANNEL_NO > channel);
+    debug_assert(NULL != curProc);
+    struct IOChannel *const ch = &ioChannels[channel];
+
+    if (ch->busy) {
+        return false;
+    }
+
+    ch->busy = true;
+    ch->owner = curProc;
+    return true;
+}
+
+bool scheduler_startKernelIO(const unsigned channel) {
+    debug_assert(IO_CHANNEL_NO > channel);
+    struct IOChannel *const ch = &ioChannels[channel];
+
+    if (ch->busy) {
+        return false;
+    }
+
+    ch->busy = true;
+    ch->owner = NULL;
+    return true;
+}
+
+bool scheduler_hasIOWaiters(const unsigned channel) {
+    debug_assert(IO_CHANNEL_NO > channel);
+    return NULL != headBlocked(&ioChannels[channel].semaphore);
+}
+
+void scheduler_waitIO(const unsigned channel, cpustate_t *const procState, const ticks_t timeLeft, const ticks_t handlerTime) {
+    debug_assert(IO_CHANNEL_NO > channel);
+    debug_assert(NULL != curProc);
+
+    blockCurProc(&ioChannels[channel].semaphore, procState, timeLeft, handlerTime);
+}
+
+const cpustate_t *scheduler_completeIO(const unsigned channel, const unsigned status, const bool handOver) {
+    debug_assert(IO_CHANNEL_NO > channel);
+    struct IOChannel *const ch = &ioChannels[channel];
+
+    if (!ch->busy) {
+        // the command was not issued through WAITIO: nobody to wake up.
+        return NULL;
+    }
+
+    if (NULL != ch->owner) {
+        struct pcb_t *const owner = outBlocked(ch->owner);
+        assert(NULL != owner);
+
+        state_setSysReturn(stateOf(owner), (int) status);
+        wakeUp(owner);
+    }
+
+    // the processes waiting for the channel are served in FIFO order.
+    ch->owner = handOver ? headBlocked(&ch->semaphore) : NULL;
+    ch->busy = (NULL != ch->owner);
+    return ch->busy ? stateOf(ch->owner) : NULL;
+}
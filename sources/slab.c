@@ -0,0 +1,31 @@
+#include <primitive_types.h>
+#include <assertions.h>
+#include <core.h>
+#include <slab.h>
+
+static_assert(0 == (SLAB_SIZE & (SLAB_SIZE - 1U)), "SLAB_SIZE must be a power of 2");
+
+// first address of the next slab; 0 until the first slab is carved
+static memaddr heapTop = 0;
+
+// lowest address reserved for the process stacks
+static memaddr stacksBottom = 0;
+
+void *slab_carve(const usize stackFramesNo) {
+    if (0 == heapTop) {
+        // the layout of the RAM is known only at run time on uMPS
+        heapTop = (MACHINE_IMAGE_END + SLAB_SIZE - 1U) & ~(SLAB_SIZE - 1U);
+        stacksBottom = MACHINE_RAM_LIMIT - MACHINE_STACK_SIZE;
+    }
+
+    const memaddr stacksSize = stackFramesNo * MACHINE_STACK_SIZE;
+
+    if (heapTop > stacksBottom || stacksBottom - heapTop < SLAB_SIZE + stacksSize) {
+        return NULL;
+    }
+
+    void *const slab = (void *) heapTop;
+    heapTop += SLAB_SIZE;
+    stacksBottom -= stacksSize;
+    return slab;
+}
@@ -0,0 +1,179 @@
+#include <primitive_types.h>
+#include <assertions.h>
+#include <helpers.h>
+#include <listx.h>
+#include <pcb.h>
+#include <sleepq.h>
+
+#define SLOT_BITS       5U
+#define SLOT_MASK       (SLEEPQ_SLOTS - 1U)
+#define SLOT_BIT(s)     (1U << (s))
+#define SPAN_SHIFT(l)   ((l) * SLOT_BITS)
+
+static_assert(SLEEPQ_SLOTS == (1U << SLOT_BITS), "the bitmap of each level is a single u32");
+static_assert(31 > SPAN_SHIFT(SLEEPQ_LEVELS), "the span of the wheel must be comparable by difference");
+
+/**
+ * Returns the level whose slots hold a process that wakes up after delta ticks.
+ */
+static unsigned levelOf(const u32 delta) {
+    return (31U - u32_clz(delta | 1U)) / SLOT_BITS;
+}
+
+static void place(struct sleepq_t *const q, struct pcb_t *const p) {
+    const unsigned level = levelOf(p->wakeup_time - q->now);
+    const unsigned slot = (p->wakeup_time >> SPAN_SHIFT(level)) & SLOT_MASK;
+    debug_assert(SLEEPQ_LEVELS > level);
+
+    list_add_tail(&p->p_next, &q->slots[level][slot]);
+    q->bitmaps[level] |= SLOT_BIT(slot);
+}
+
+/**
+ * Unlinks the first process of a slot.
+ */
+static struct pcb_t *takeFirst(struct sleepq_t *const q, const unsigned level, const unsigned slot) {
+    struct list_head *const head = &q->slots[level][slot];
+    struct pcb_t *const p = container_of(head->next, struct pcb_t, p_next);
+
+    list_del(&p->p_next);
+    INIT_LIST_HEAD(&p->p_next);
+    if (list_empty(head)) {
+        q->bitmaps[level] &= ~SLOT_BIT(slot);
+    }
+
+    return p;
+}
+
+/**
+ * Spreads over the lower levels the slots whose span starts at the current tick, highest level first.
+ */
+static void cascade(struct sleepq_t *const q) {
+    for (unsigned level = SLEEPQ_LEVELS - 1; 0 < level; --level) {
+        if (0 == (q->now & (SLOT_BIT(SPAN_SHIFT(level)) - 1U))) {
+            const unsigned slot = (q->now >> SPAN_SHIFT(level)) & SLOT_MASK;
+
+            while (0 != (q->bitmaps[level] & SLOT_BIT(slot))) {
+                place(q, takeFirst(q, level, slot));
+            }
+        }
+    }
+}
+
+void mkEmptySleepQ(struct sleepq_t *const q, const ticks_t now) {
+    debug_assert(NULL != q);
+    q->now = now;
+
+    for (unsigned level = 0; level < SLEEPQ_LEVELS; ++level) {
+        q->bitmaps[level] = 0;
+
+        for (unsigned slot = 0; slot < SLEEPQ_SLOTS; ++slot) {
+            INIT_LIST_HEAD(&q->slots[level][slot]);
+        }
+    }
+}
+
+int emptySleepQ(const struct sleepq_t *const q) {
+    debug_assert(NULL != q);
+
+    for (unsigned level = 0; level < SLEEPQ_LEVELS; ++level) {
+        if (0 != q->bitmaps[level]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void insertSleepQ(struct sleepq_t *const q, struct pcb_t *const p, const ticks_t wakeup) {
+    debug_assert(NULL != q);
+    debug_assert(NULL != p);
+    debug_assert(PcbQueue_None == p->p_queue || PcbQueue_Running == p->p_queue);
+    debug_assert(0 < wakeup - q->now && wakeup - q->now <= SLEEPQ_MAX_DELAY);
+
+    p->p_queue = PcbQueue_Sleeping;
+    p->wakeup_time = wakeup;
+    place(q, p);
+}
+
+struct pcb_t *removeSleepQ(struct sleepq_t *const q, const ticks_t now) {
+    debug_assert(NULL != q);
+
+    for (;;) {
+        // level 0 has one slot per tick: the slot of the current tick holds the due processes.
+        const unsigned due = q->now & SLOT_MASK;
+
+        if (0 != (q->bitmaps[0] & SLOT_BIT(due))) {
+            struct pcb_t *const p = takeFirst(q, 0, due);
+            debug_assert(PcbQueue_Sleeping == p->p_queue);
+
+            p->p_queue = PcbQueue_None;
+            return p;
+        }
+
+        // An empty wheel has nothing to skip: it is moved to now however long it has been
+        // left alone, so that the next insertion is measured from there.
+        if (emptySleepQ(q)) {
+            q->now = now;
+            return NULL;
+        }
+
+        // No event can be skipped: the wheel jumps from one to the next, up to now.
+        if ((i32) (nextEventSleepQ(q) - now) > 0) {
+            q->now = ((i32) (now - q->now) > 0) ? now : q->now;
+            return NULL;
+        }
+
+        q->now = nextEventSleepQ(q);
+        cascade(q);
+    }
+}
+
+struct pcb_t *outSleepQ(struct sleepq_t *const q, struct pcb_t *const p) {
+    debug_assert(NULL != q);
+    debug_assert(NULL != p);
+    debug_assert(PcbQueue_Sleeping == p->p_queue);
+    debug_assert(!list_empty(&p->p_next));
+    struct list_head *const next = p->p_next.next;
+    struct list_head *const first = &q->slots[0][0];
+
+    p->p_queue = PcbQueue_None;
+    list_del(&p->p_next);
+    INIT_LIST_HEAD(&p->p_next);
+
+    // if p was the last entry of its slot, next is now an empty slot of q.
+    if (list_empty(next) && first <= next && next < first + SLEEPQ_LEVELS * SLEEPQ_SLOTS) {
+        const unsigned index = (unsigned) (next - first);
+        q->bitmaps[index / SLEEPQ_SLOTS] &= ~SLOT_BIT(index % SLEEPQ_SLOTS);
+    }
+
+    return p;
+}
+
+ticks_t nextEventSleepQ(const struct sleepq_t *const q) {
+    debug_assert(NULL != q);
+    debug_assert(!emptySleepQ(q));
+    u32 nearest = SLEEPQ_MAX_DELAY + 1U;
+
+    if (0 != (q->bitmaps[0] & SLOT_BIT(q->now & SLOT_MASK))) {
+        return q->now;
+    }
+
+    for (unsigned level = 0; level < SLEEPQ_LEVELS; ++level) {
+        const u32 bitmap = q->bitmaps[level];
+
+        if (0 != bitmap) {
+            // Rotating the bitmap so that the slot next to the current one comes first, the
+            // lowest set bit tells how many spans ahead the first non-empty slot begins.
+            const u32 base = q->now >> SPAN_SHIFT(level);
+            const unsigned shift = (base + 1U) & SLOT_MASK;
+            const u32 ahead = (0 == shift) ? bitmap : (bitmap >> shift) | (bitmap << (SLEEPQ_SLOTS - shift));
+            const u32 spans = 32U - u32_clz(ahead & (0U - ahead));
+            const u32 distance = ((base + spans) << SPAN_SHIFT(level)) - q->now;
+
+            nearest = (distance < nearest) ? distance : nearest;
+        }
+    }
+
+    return q->now + nearest;
+}
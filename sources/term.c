@@ -5,17 +5,8 @@
 
 // NOTE: keep this portion of code free of arch-specific code!
 
-// High level states of a terminal device.
-enum TermStatus {
-    TERM_STATUS_OK,
-    TERM_STATUS_ERR,
-    TERM_STATUS_BUSY,
-    TERM_STATUS_READY,
-    TERM_STATUS_ABSENT,
-};
-
-static enum TermStatus transmit(unsigned handle, char c);
-static enum TermStatus receive(unsigned handle, char *buf);
+static usize transmit(unsigned handle, const char *buf, usize len);
+static usize receive(unsigned handle, char *buf, usize size);
 
 static bool isNewline(const char c) {
     return '\n' == c;
@@ -23,49 +14,58 @@ static bool isNewline(const char c) {
 
 bool term_putchar(const unsigned handle, const char character) {
     debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
-
-    switch(transmit(handle, character)) {
-        case TERM_STATUS_OK:
-            /* FALLTHROUGH */
-        case TERM_STATUS_READY:
-            return true;
-
-        default:
-            return false;
-    }
+    return 1 == transmit(handle, &character, 1);
 }
 
 usize term_puts(const unsigned handle, const char *str) {
     debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
-    usize i = 0;
+    usize len = 0;
 
     if (NULL != str) {
-        while (*str && term_putchar(handle, *(str++))) {
-            ++i;
+        while (str[len]) {
+            ++len;
         }
     }
 
-    return i;
+    return transmit(handle, str, len);
+}
+
+usize term_write(const unsigned handle, const char *const buf, const usize len) {
+    debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
+    return (NULL == buf) ? 0 : transmit(handle, buf, len);
 }
 
 bool term_getchar(const unsigned handle, char *const buf) {
     debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
+    char c = 0;
 
-    switch(receive(handle, buf)) {
-        case TERM_STATUS_OK:
-            /* FALLTHROUGH */
-        case TERM_STATUS_READY:
-            return true;
+    if (1 != receive(handle, &c, 1)) {
+        return false;
+    }
 
-        default:
-            return false;
+    if (NULL != buf) {
+        *buf = c;
     }
+
+    return true;
 }
 
 usize term_gets(const unsigned handle, bool (*p)(char), char *buf, const usize n) {
     debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
     usize i = 1;
     bool stop = false;
+
+    if (NULL == p && NULL != buf && 1 < n) {
+        // a whole line is read with a single READLINE.
+        const usize len = receive(handle, buf, n - 1);
+
+        if (0 < len) {
+            buf[len] = '\0';
+        }
+
+        return len;
+    }
+
     p = (NULL == p) ? isNewline : p;
 
     if (NULL == buf) {
@@ -106,64 +106,32 @@ usize term_gets(const unsigned handle, bool (*p)(char), char *buf, const usize n
 #error "Unknown target architecture"
 #endif
 
-#define RAW_STATUS_OK        5U
-#define RAW_STATUS_ERR       4U
-#define RAW_STATUS_BUSY      3U
-#define RAW_STATUS_READY     1U
-#define RAW_STATUS_ABSENT    0U
-
-#define CMD_ACK              1U
-#define CMD_TRANSMIT         2U
-#define CMD_RECEIVE          2U
-
-#define BYTE_OFFSET          8U
-#define BYTE_MASK            0xFFU
-
-static enum TermStatus decodeStatus(unsigned rawStatus);
-
-static enum TermStatus transmit(const unsigned handle, const char c) {
+static usize transmit(const unsigned handle, const char *buf, usize len) {
     debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
+    usize i = 0;
 
-    unsigned command = c;
-    command <<= BYTE_OFFSET;
-    command |= CMD_TRANSMIT;
-
-    return decodeStatus((unsigned) SYSCALL(WAITIO, command, DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, handle), 0));
-}
-
-static enum TermStatus receive(const unsigned handle, char *const buf) {
-    debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
+    // WRITE queues as many characters as there is room for, blocking only if the queue is full.
+    while (i < len) {
+        const int n = SYSCALL(WRITE, DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, handle), (memaddr) (buf + i), len - i);
 
-    const unsigned rawStatus = (unsigned) SYSCALL(WAITIO, CMD_RECEIVE, DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, handle), 1);
-    const enum TermStatus status = decodeStatus(rawStatus);
+        if (0 > n) {
+            break;
+        }
 
-    if (TERM_STATUS_OK == status && NULL != buf) {
-        //  | OPAQUE | OPAQUE |  CHAR  | STATUS |
-        // 31       23       15        7        0
-        *buf = (char) ((rawStatus >> BYTE_OFFSET) & BYTE_MASK);
+        i += (usize) n;
     }
 
-    return status;
+    return i;
 }
 
-static enum TermStatus decodeStatus(const unsigned rawStatus) {
-    switch (rawStatus & BYTE_MASK) {
-        case RAW_STATUS_OK:
-            return TERM_STATUS_OK;
-
-        case RAW_STATUS_ERR:
-            return TERM_STATUS_ERR;
-
-        case RAW_STATUS_BUSY:
-            return TERM_STATUS_BUSY;
-
-        case RAW_STATUS_READY:
-            return TERM_STATUS_READY;
-
-        case RAW_STATUS_ABSENT:
-            return TERM_STATUS_ABSENT;
+static usize receive(const unsigned handle, char *const buf, const usize size) {
+    debug_assert(handle < MACHINE_DEVICE_TERMINAL_NO);
+    int n = 0;
 
-        default:
-            unreachable();
+    // READLINE returns 0 if it had to wait for a line to be completed: ask again.
+    while (0 == n) {
+        n = SYSCALL(READLINE, DEV_REG_ADDR(INTERRUPT_LINE_TERMINAL, handle), (memaddr) buf, size);
     }
+
+    return (0 > n) ? 0 : (usize) n;
 }
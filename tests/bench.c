@@ -0,0 +1,42 @@
+#include <bench.h>
+#include <assertions.h>
+#include <helpers.h>
+#include <term.h>
+#include <scheduler.h>
+
+static bool putChar(const char c) {
+    return term_putchar(0, c);
+}
+
+noreturn void bench_run(const struct BenchProcess *const processes, const usize n) {
+    debug_assert(NULL != processes);
+    debug_assert(0 < n);
+
+    core_boot();
+
+    for (usize i = 0; i < n; ++i) {
+        for (unsigned j = 0; j < processes[i].copies; ++j) {
+            if (!scheduler_scheduleWith(processes[i].entry, processes[i].priority, processes[i].interruptsEnabled)) {
+                trace("unable to schedule a process");
+                core_panic();
+            }
+        }
+    }
+
+    scheduler_dispatch();
+    unreachable();
+}
+
+void bench_puts(const char *const str) {
+    term_puts(0, str);
+}
+
+void bench_putu(const u32 n) {
+    u32_to_base10(putChar, n);
+}
+
+void bench_report(const char *const label, const u32 n, const char *const unit) {
+    bench_puts(label);
+    bench_putu(n);
+    bench_puts(unit);
+}
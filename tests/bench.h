@@ -0,0 +1,53 @@
+#pragma once
+
+#include <primitive_types.h>
+#include <core.h>
+
+/**
+ * Support code shared by the benchmark and test kernels: printing results on
+ * terminal 0 and booting the kernel with the processes to be run.
+ */
+
+/**
+ * A process to be scheduled at boot, copies times.
+ */
+struct BenchProcess {
+    void (*entry)(void);
+    int priority;
+    bool interruptsEnabled;
+    unsigned copies;
+};
+
+/**
+ * Defines the main of a kernel which boots and runs the given processes,
+ * each one written as a struct BenchProcess initializer, e.g.
+ *
+ *     BENCH_MAIN({ .entry=bench, .priority=1, .copies=1 })
+ */
+#define BENCH_MAIN(...)                                                                 \
+    int main(void) {                                                                    \
+        static const struct BenchProcess processes[] = { __VA_ARGS__ };                 \
+        bench_run(processes, sizeof(processes) / sizeof(processes[0]));                 \
+    }
+
+/**
+ * Boots the kernel, schedules the processes in order and dispatches the first one.
+ *
+ * @attention (NULL == processes) or (0 == n) is CRE.
+ */
+extern noreturn void bench_run(const struct BenchProcess *processes, usize n);
+
+/**
+ * Prints str on terminal 0.
+ */
+extern void bench_puts(const char *str);
+
+/**
+ * Prints n in base 10 on terminal 0.
+ */
+extern void bench_putu(u32 n);
+
+/**
+ * Prints label, n in base 10 and unit on terminal 0, one after the other.
+ */
+extern void bench_report(const char *label, u32 n, const char *unit);